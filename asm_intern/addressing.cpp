@@ -37,10 +37,13 @@ Y + address
 
 ind(address): ind
     :: ind(zpg) = ind
+    :: ind(abs) = ind (JMP only, the others take a zero page pointer)
 ind(address + X): indx
     :: ind(zpgx) = indx
+    :: ind(absx) = indx (JMP only)
 ind(X + address): indx
     :: ind(zpgx) = indx
+    :: ind(absx) = indx (JMP only)
 ind(address) + Y: indy
     :: ind + regy = indy
 Y + ind(address): indy
@@ -229,31 +232,32 @@ struct classify_complex_parameter : public const_expression_visitor {
 private:
     const std::unordered_map<std::string, value_range> &_labels;
     std::shared_ptr<expression> &_value;
+    logger &_log;
 public:
-    classify_complex_parameter(const std::unordered_map<std::string, value_range> &labels, std::shared_ptr<expression> &value)
-    : _labels(labels), _value(value)
+    classify_complex_parameter(const std::unordered_map<std::string, value_range> &labels, std::shared_ptr<expression> &value, logger &log)
+    : _labels(labels), _value(value), _log(log)
     {}
 
     addressing_mode _mode;
     bool _ok = true;
 
     virtual void visit(const value_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 
     virtual void visit(const label_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 
     virtual void visit(const addr_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 
     virtual void visit(const reg_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 
@@ -261,8 +265,8 @@ public:
         // zpg+X, abs+X, zpg+Y, abs+Y, ind+Y
         addressing_mode lhs, rhs;
         std::shared_ptr<expression> vlhs, vrhs;
-        _ok = tryDetermineAddressingMode(_labels, exp->lhs, lhs, vlhs);
-        _ok = tryDetermineAddressingMode(_labels, exp->rhs, rhs, vrhs);
+        _ok = tryDetermineAddressingMode(_labels, exp->lhs, lhs, vlhs, _log);
+        _ok = tryDetermineAddressingMode(_labels, exp->rhs, rhs, vrhs, _log);
         if (_ok) {
             switch(lhs) {
                 case addressing_mode::zpg: // zpg+X or zpg+Y
@@ -275,7 +279,7 @@ public:
                             _mode = addressing_mode::zpgy;
                             break;
                         default:
-                            logger::def->log("Unsupported additive addressing mode");
+                            _log.log("Unsupported additive addressing mode");
                             _ok = false;
                             break;
                     }
@@ -290,7 +294,7 @@ public:
                             _mode = addressing_mode::absy;
                             break;
                         default:
-                            logger::def->log("Unsupported additive addressing mode");
+                            _log.log("Unsupported additive addressing mode");
                             _ok = false;
                             break;
                     }
@@ -302,7 +306,7 @@ public:
                             _mode = addressing_mode::indy;
                             break;
                         default:
-                            logger::def->log("Unsupported additive addressing mode");
+                            _log.log("Unsupported additive addressing mode");
                             _ok = false;
                             break;
                     }
@@ -317,7 +321,7 @@ public:
                             _mode = addressing_mode::absx;
                             break;
                         default:
-                            logger::def->log("Unsupported additive addressing mode");
+                            _log.log("Unsupported additive addressing mode");
                             _ok = false;
                             break;
                     }
@@ -335,13 +339,13 @@ public:
                             _mode = addressing_mode::indy;
                             break;
                         default:
-                            logger::def->log("Unsupported additive addressing mode");
+                            _log.log("Unsupported additive addressing mode");
                             _ok = false;
                             break;
                     }
                     break;
                 default:
-                    logger::def->log("Unsupported additive addressing mode");
+                    _log.log("Unsupported additive addressing mode");
                     _ok = false;
                     break;
             }
@@ -349,30 +353,32 @@ public:
     }
 
     virtual void visit(const subtract_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 
     virtual void visit(const multiply_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 
     virtual void visit(const indirect_addr_expression* exp) override {
         addressing_mode mode;
-        _ok = tryDetermineAddressingMode(_labels, exp->addr, mode, _value);
+        _ok = tryDetermineAddressingMode(_labels, exp->addr, mode, _value, _log);
         if (_ok) {
             switch(mode) {
                 case addressing_mode::zpg:
-                    // [$12]
+                case addressing_mode::abs:
+                    // [$12], or JMP [$1234]
                     _mode = addressing_mode::ind;
                     break;
                 case addressing_mode::zpgx:
-                    // [$12 + #X]
+                case addressing_mode::absx:
+                    // [$12 + #X], or JMP [$1234 + #X]
                     _mode = addressing_mode::indx;
                     break;
                 default:
-                    logger::def->log("Unsupported indirect addressing.");
+                    _log.log("Unsupported indirect addressing.");
                     _ok = false;
                     break;
             }
@@ -380,28 +386,28 @@ public:
     }
 
     virtual void visit(const func_expression* exp) override {
-        logger::def->log("Unsupported expression");
+        _log.log("Unsupported expression");
         _ok = false;
     }
 };
 
-inline void log_out_of_range(const value_range &value, const REG16 &lo, const REG16 &hi, const std::string &addressing) {
+inline void log_out_of_range(const value_range &value, const REG16 &lo, const REG16 &hi, const std::string &addressing, logger &log) {
     if (value.first < lo) {
-        logger::def->log() << "The value (" << value.first << ") for " << addressing << " addressing is out-of-range" << end();
+        log.log() << "The value (" << value.first << ") for " << addressing << " addressing is out-of-range" << end();
     }
     else {
-        logger::def->log() << "The value (" << value.second << ") for " << addressing << " addressing is out-of-range" << end();
+        log.log() << "The value (" << value.second << ") for " << addressing << " addressing is out-of-range" << end();
     }
 }
 
-bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_range> &labels, const std::shared_ptr<expression> &parameter, addressing_mode &mode, std::shared_ptr<expression> &value)
+bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_range> &labels, const std::shared_ptr<expression> &parameter, addressing_mode &mode, std::shared_ptr<expression> &value, logger &log)
 {
     classify_parameter cp(labels);
     parameter->accept(&cp);
     switch(cp._kind) {
         case parameter_kind::complex:
             if (true) {
-                classify_complex_parameter ccp(labels, value);
+                classify_complex_parameter ccp(labels, value, log);
                 parameter->accept(&ccp);
                 mode = ccp._mode;
                 return ccp._ok;
@@ -409,7 +415,7 @@ bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_rang
             break;
         case parameter_kind::value:
             if (cp._value.first < 0 || cp._value.second > 255) {
-                log_out_of_range(cp._value, 0, 255, "immediate");
+                log_out_of_range(cp._value, 0, 255, "immediate", log);
                 return false;
             }
             else {
@@ -428,11 +434,11 @@ bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_rang
             return true;
         case parameter_kind::address:
             if (cp._value.first < 0 || cp._value.second > 0xFFFF) {
-                log_out_of_range(cp._value, 0, 0xFFFF, "absolute");
+                log_out_of_range(cp._value, 0, 0xFFFF, "absolute", log);
                 return false;
             }
             else if (cp._value.first < 256 && cp._value.second >= 256) {
-                logger::def->log() << "Unable to determine whether an address is in page zero. The value span the address space " << cp._value.first << " to " << cp._value.second << end();
+                log.log() << "Unable to determine whether an address is in page zero. The value span the address space " << cp._value.first << " to " << cp._value.second << end();
                 return false;
             }
             else if (cp._value.second < 256) {
@@ -446,7 +452,7 @@ bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_rang
         default:
             break;
     }
-    logger::def->log("Unsupported expression");
+    log.log("Unsupported expression");
     return false;
 }
 
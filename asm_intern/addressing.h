@@ -8,7 +8,9 @@
 
 namespace dave
 {
-    bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_range> &labels, const std::shared_ptr<expression> &parameter, addressing_mode &mode, std::shared_ptr<expression> &value);
+    class logger;
+
+    bool tryDetermineAddressingMode(const std::unordered_map<std::string, value_range> &labels, const std::shared_ptr<expression> &parameter, addressing_mode &mode, std::shared_ptr<expression> &value, logger &log);
 }
 
 #endif
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include "code_generator.h"
 #include "pc_code_generator.h"
 #include "rom_code_generator.h"
+#include "image_code_generator.h"
+#include "pcb_code_generator.h"
 
 #include "parser.h"
 #include "logger.h"
@@ -18,16 +20,15 @@
 
 int main(int argc, char *argv[])
 {
-    dave::stm_logger slogger(std::cerr);
-    dave::logger::def = &slogger;
-    dave::logger::def->_filename.clear();
-    dave::logger::def->_line_no = 0;
+    dave::stm_logger log(std::cerr);
+    log._filename.clear();
+    log._line_no = 0;
 
     if (argc == 2 && std::string(argv[1]) == "--help") {
         std::cout << "intern [options]" << std::endl;
         std::cout << " -i  : specify input file (stdin if not specified)" << std::endl;
         std::cout << " -o  : specify output file (stdout if not specified)" << std::endl;
-        std::cout << " -fmt: format, 'punchcard' or 'rom'" << std::endl;
+        std::cout << " -fmt: format, 'punchcard', 'punchcard-binary', 'rom' or 'image'" << std::endl;
         return 0;
     }
 
@@ -58,12 +59,16 @@ int main(int argc, char *argv[])
         }
     }
 
+    // The binary formats write raw bytes, so the output file must not translate line ends
+    auto f = args.find("-fmt");
+    bool binary_output = f != args.end() && f->second.size() == 1 && (f->second[0] == "image" || f->second[0] == "punchcard-binary");
+
     std::ostream *ostm;
     std::ofstream ofstm;
-    auto f = args.find("-o");
+    f = args.find("-o");
     if (f != args.end()) {
         if (f->second.size() == 1) {
-            ofstm.open(f->second[0]);
+            ofstm.open(f->second[0], binary_output ? std::ios::out | std::ios::binary : std::ios::out);
             if (!ofstm) {
                 std::cerr << "Failure opening '" << f->second[0] << "' for output" << std::endl;
                 return 1;
@@ -91,11 +96,17 @@ int main(int argc, char *argv[])
             if (f->second[0] == "punchcard") {
                 code_gen.reset(new dave::pc_code_generator(*ostm));
             }
+            else if (f->second[0] == "punchcard-binary") {
+                code_gen.reset(new dave::pcb_code_generator(*ostm));
+            }
             else if (f->second[0] == "rom") {
                 code_gen.reset(new dave::rom_code_generator(*ostm));
             }
+            else if (f->second[0] == "image") {
+                code_gen.reset(new dave::image_code_generator(*ostm));
+            }
             else {
-                std::cerr << "Unsupported format '" << f->second[0] << "' encountered. Use 'punchcard' or 'rom'" << std::endl;
+                std::cerr << "Unsupported format '" << f->second[0] << "' encountered. Use 'punchcard', 'punchcard-binary', 'rom' or 'image'" << std::endl;
                 return 1;
             }
         }
@@ -115,18 +126,18 @@ int main(int argc, char *argv[])
         for(auto &fn : f->second) {
             files.emplace_back();
             files.back().filename = fn;
-            if (!dave::tryParse(files.back())) {
+            if (!dave::tryParse(files.back(), log)) {
                 return 1;
             }
         }
     }
 
     dave::REG16 startAddress;
-    if (!dave::tryLayout(files, startAddress)) {
+    if (!dave::tryLayout(files, startAddress, log)) {
         return 1;
     }
 
-    if (!code_gen->try_generate(files, startAddress)) {
+    if (!code_gen->try_generate(files, startAddress, log)) {
         return 1;
     }
 
@@ -6,4 +6,24 @@ namespace dave
 code_generator::~code_generator()
 {}
 
+void append_card_lines(const instr &i, REG16 &cur, std::vector<card_line> &lines)
+{
+    REG16 addr = i._address;
+    if (addr != cur) {
+        lines.emplace_back(2, addr & 0xFF);
+        lines.emplace_back(3, addr >> 8);
+    }
+    for(auto &b : i._binary_representation) {
+        lines.emplace_back(1, b);
+        addr++;
+    }
+    cur = addr;
+}
+
+void append_start_lines(REG16 startAddress, std::vector<card_line> &lines)
+{
+    lines.emplace_back(2, startAddress & 0xFF);
+    lines.emplace_back(3, startAddress >> 8);
+}
+
 }
\ No newline at end of file
@@ -2,10 +2,22 @@
 #define __CODE_GENERATORH
 
 #include "ast.h"
+#include <utility>
 #include <vector>
 
 namespace dave
 {
+    class logger;
+
+    // A line of a punch card: (instruction, data). 1 = data, 2 = address lo, 3 = address hi
+    typedef std::pair<REG8, REG8> card_line;
+
+    // The punch card lines of an instruction: the address lines when it doesn't follow the previous instruction (at
+    // 'cur'), then a data line per byte. Moves 'cur' past the instruction.
+    void append_card_lines(const instr &i, REG16 &cur, std::vector<card_line> &lines);
+    // The lines that run the program at the start address
+    void append_start_lines(REG16 startAddress, std::vector<card_line> &lines);
+
     class code_generator {
     public:
         code_generator() = default;
@@ -17,7 +29,7 @@ namespace dave
         auto operator =(const code_generator&) -> code_generator& = delete;
         auto operator =(code_generator&&) -> code_generator& = delete;
 
-        virtual bool try_generate(const std::vector<file> &files, const REG16 startAddress) = 0;
+        virtual bool try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log) = 0;
     };
 }
 
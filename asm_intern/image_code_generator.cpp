@@ -0,0 +1,49 @@
+#include "image_code_generator.h"
+
+#include "logger.h"
+
+namespace dave
+{
+
+image_code_generator::image_code_generator(std::ostream &output)
+: _output(output)
+{
+}
+
+image_code_generator::~image_code_generator()
+{}
+
+bool image_code_generator::try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log)
+{
+    std::vector<REG8> image(0x10000, 0);
+    size_t lowest = 0x10000, highest = 0;
+    for(auto &f : files) {
+        for(auto &l : f.lines) {
+            if (l._instr != nullptr) {
+                size_t addr = l._instr->_address;
+                for(auto &i : l._instr->_binary_representation) {
+                    if (addr > 0xFFFF) {
+                        log._filename = f.filename;
+                        log._line_no = l._line_no;
+                        log.log("The instruction does not fit in the address space");
+                        return false;
+                    }
+                    image[addr] = i;
+                    if (addr < lowest) lowest = addr;
+                    if (addr > highest) highest = addr;
+                    addr++;
+                }
+            }
+        }
+    }
+    // The header: "XROM" and the address of the first byte (lo byte first)
+    size_t base = lowest <= highest ? lowest : startAddress;
+    REG8 header[6] = { 'X', 'R', 'O', 'M', (REG8)(base & 0xFF), (REG8)(base >> 8) };
+    _output.write((const char*)header, sizeof(header));
+    if (lowest <= highest) {
+        _output.write((const char*)&image[lowest], highest - lowest + 1);
+    }
+    return (bool)_output;
+}
+
+}
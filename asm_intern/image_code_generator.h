@@ -0,0 +1,29 @@
+#ifndef __IMAGE_CODE_GENERATORH
+#define __IMAGE_CODE_GENERATORH
+
+#include "code_generator.h"
+#include <ostream>
+
+namespace dave
+{
+    // Writes a binary image: "XROM" and the lowest address used (2 bytes, lo byte first), then the bytes from the
+    // lowest address used to the highest. Gaps are filled with zeros. The image can be loaded by rom::load at runtime.
+    class image_code_generator : public code_generator {
+    private:
+        std::ostream &_output;
+    public:
+        image_code_generator() = delete;
+        image_code_generator(const image_code_generator&) = delete;
+        image_code_generator(image_code_generator&&) = delete;
+        explicit image_code_generator(std::ostream &output);
+
+        virtual ~image_code_generator();
+
+        auto operator =(const image_code_generator&) -> image_code_generator& = delete;
+        auto operator =(image_code_generator&&) -> image_code_generator& = delete;
+
+        virtual bool try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log) override;
+    };
+}
+
+#endif
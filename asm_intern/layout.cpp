@@ -14,9 +14,10 @@ namespace dave
 struct evaluator : public const_expression_visitor {
 private:
     const std::unordered_map<std::string, value_range> &_labels;
+    logger &_log;
 public:
-    evaluator(const std::unordered_map<std::string, value_range> &labels)
-    : _labels(labels), _ok(true)
+    evaluator(const std::unordered_map<std::string, value_range> &labels, logger &log)
+    : _labels(labels), _log(log), _ok(true)
     {}
 
     bool _ok;
@@ -29,7 +30,7 @@ public:
     virtual void visit(const label_expression* exp) override {
         auto f = _labels.find(exp->name);
         if (f == _labels.end()) {
-            logger::def->log() << "The label '" << exp->name << "' could not be found" << end();
+            _log.log() << "The label '" << exp->name << "' could not be found" << end();
             _ok = false;
         }
         else {
@@ -42,7 +43,7 @@ public:
     }
 
     virtual void visit(const reg_expression* exp) override {
-        logger::def->log("Register has a non-static value");
+        _log.log("Register has a non-static value");
         _ok = false;
     }
 
@@ -87,7 +88,7 @@ public:
     }
 
     virtual void visit(const indirect_addr_expression* exp) override {
-        logger::def->log("Indirect address has a non-static value");
+        _log.log("Indirect address has a non-static value");
         _ok = false;
     }
 
@@ -150,7 +151,7 @@ void getInstructionSizeRange(instr_kind kind, value_range &size)
         { 1,   3 }, // DEC
         { 1,   3 }, // INC
         { 2,   3 }, // EOR
-        { 2,   3 }, // JMP
+        { 3,   3 }, // JMP
         { 3,   3 }, // JSR
         { 2,   3 }, // LDA
         { 2,   3 }, // LDX
@@ -185,7 +186,7 @@ void getInstructionSizeRange(instr_kind kind, value_range &size)
     size.second = s[1];
 }
 
-bool tryResolveInstructionSize(instr_kind kind, addressing_mode mode, size_t &size)
+bool tryResolveInstructionSize(instr_kind kind, addressing_mode mode, size_t &size, logger &log)
 {
     static int sizes[][13] = {
         //imm, abs, absx, absy, zpg, zpgx, zpgy, ind, indx, indy, acc, regx, regy
@@ -220,7 +221,7 @@ bool tryResolveInstructionSize(instr_kind kind, addressing_mode mode, size_t &si
         {-1,   3,   3,   -1,    2,   2,   -1,   -1,  -1,   -1,    1,   1,    1 }, // DEC
         {-1,   3,   3,   -1,    2,   2,   -1,   -1,  -1,   -1,    1,   1,    1 }, // INC
         { 2,   3,   3,    3,    2,   2,   -1,    2,   2,    2,   -1,  -1,   -1 }, // EOR
-        {-1,   3,  -1,   -1,   -1,  -1,   -1,    2,   2,   -1,   -1,  -1,   -1 }, // JMP
+        {-1,   3,  -1,   -1,   -1,  -1,   -1,    3,   3,   -1,   -1,  -1,   -1 }, // JMP
         {-1,   3,  -1,   -1,    3,  -1,   -1,   -1,  -1,   -1,   -1,  -1,   -1 }, // JSR
         { 2,   3,   3,    3,    2,   2,   -1,    2,   2,    2,   -1,  -1,   -1 }, // LDA
         { 2,   3,  -1,    3,    2,  -1,    2,   -1,  -1,   -1,   -1,  -1,   -1 }, // LDX
@@ -251,7 +252,7 @@ bool tryResolveInstructionSize(instr_kind kind, addressing_mode mode, size_t &si
     };
     int s = sizes[(int)kind][(int)mode];
     if (s == -1) {
-        logger::def->log() << "Unsupported addressing mode for the instruction. The '" << kind << "' instruction does not support " << mode << end();
+        log.log() << "Unsupported addressing mode for the instruction. The '" << kind << "' instruction does not support " << mode << end();
         return false;
     }
     else {
@@ -360,7 +361,7 @@ inline bool is_branch_instr(instr_kind kind) {
 //     }
 // }
 
-bool tryLayout(std::vector<file> &files, REG16 &startAddress)
+bool tryLayout(std::vector<file> &files, REG16 &startAddress, logger &log)
 {
     std::shared_ptr<expression> start;
     std::unordered_map<std::string, value_range> labels;
@@ -383,7 +384,7 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
                     getInstructionSizeRange(l._instr->_kind, l._instr->_instr_size_range);
                     if (!l._instr->_label.empty()) {
                         if (!labels.emplace(l._instr->_label, value_range(0x0000, 0xFFFF)).second) {
-                            logger::def->log() << "The label '" << l._instr->_label << "' was defined more than once" << end();
+                            log.log() << "The label '" << l._instr->_label << "' was defined more than once" << end();
                             return false;
                         }
                     }
@@ -398,17 +399,17 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
         changes = false;
         value_range cur(0x0000, 0x0000);
         for(auto &f : files) {
-            logger::def->_filename = f.filename;
-            logger::def->_line_no = 0;
+            log._filename = f.filename;
+            log._line_no = 0;
             for(auto &l : f.lines) {
-                logger::def->_line_no = l._line_no;
+                log._line_no = l._line_no;
                 if (l._instr != nullptr) {
                     if (l._instr->_kind == instr_kind::BASE) {
                         if (l._instr->_parameter == nullptr) {
-                            logger::def->log("The BASE instruction requires a parameter with a type of 'addr'");
+                            log.log("The BASE instruction requires a parameter with a type of 'addr'");
                             return false;
                         }
-                        evaluator eval(labels);
+                        evaluator eval(labels, log);
                         l._instr->_parameter->accept(&eval);
                         if (!eval._ok) {
                             return false;
@@ -440,12 +441,12 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
 
     // Now we should have an accurate picture of where the labels will be (approx) and should be able to find the addressing modes
     for(auto &f : files) {
-        logger::def->_filename = f.filename;
-        logger::def->_line_no = 0;
+        log._filename = f.filename;
+        log._line_no = 0;
         for(auto &l : f.lines) {
-            logger::def->_line_no = l._line_no;
+            log._line_no = l._line_no;
             if (l._instr != nullptr && l._instr->_parameter != nullptr && l._instr->_kind != instr_kind::BASE && l._instr->_kind != instr_kind::DATA) {
-                if (!tryDetermineAddressingMode(labels, l._instr->_parameter, l._instr->_addressing_mode, l._instr->_addressing_mode_parameter)) {
+                if (!tryDetermineAddressingMode(labels, l._instr->_parameter, l._instr->_addressing_mode, l._instr->_addressing_mode_parameter, log)) {
                     return false;
                 }
             }
@@ -454,10 +455,10 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
 
     // All addressing mode are now known, thus we know the size of all instructions, except DATA instructions.
     for(auto &f : files) {
-        logger::def->_filename = f.filename;
-        logger::def->_line_no = 0;
+        log._filename = f.filename;
+        log._line_no = 0;
         for(auto &l : f.lines) {
-            logger::def->_line_no = l._line_no;
+            log._line_no = l._line_no;
             if (l._instr != nullptr) {
                 if (l._instr->_kind == instr_kind::BASE) {
                     l._instr->_instr_size = 0;
@@ -465,7 +466,7 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
                 else if (l._instr->_kind == instr_kind::DATA) {
                 }
                 else {
-                    if (!tryResolveInstructionSize(l._instr->_kind, l._instr->_addressing_mode, l._instr->_instr_size)) {
+                    if (!tryResolveInstructionSize(l._instr->_kind, l._instr->_addressing_mode, l._instr->_instr_size, log)) {
                         return false;
                     }
                 }
@@ -479,13 +480,13 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
         changes = false;
         value_range cur(0x0000, 0x0000);
         for(auto &f : files) {
-            logger::def->_filename = f.filename;
-            logger::def->_line_no = 0;
+            log._filename = f.filename;
+            log._line_no = 0;
             for(auto &l : f.lines) {
-                logger::def->_line_no = l._line_no;
+                log._line_no = l._line_no;
                 if (l._instr != nullptr) {
                     if (l._instr->_kind == instr_kind::BASE) {
-                        evaluator eval(labels);
+                        evaluator eval(labels, log);
                         l._instr->_parameter->accept(&eval);
                         if (!eval._ok) {
                             return false;
@@ -507,13 +508,13 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
                             }
                         }
                         // Update the info on this parameter
-                        evaluator eval(labels);
+                        evaluator eval(labels, log);
                         l._instr->_parameter->accept(&eval);
                         if (!eval._ok) {
                             return false;
                         }
                         if (eval._value.first < 0 || eval._value.second > 0xFFFF) {
-                            logger::def->log("Parameter of DATA instruction is out of range");
+                            log.log("Parameter of DATA instruction is out of range");
                             return false;
                         }
                         auto f = eval._value.first < 256 ? 1 : 2;
@@ -550,10 +551,10 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
 
     // At this point, if the some address is still unsure, then we cannot determine it
     for(auto &f : files) {
-        logger::def->_filename = f.filename;
-        logger::def->_line_no = 0;
+        log._filename = f.filename;
+        log._line_no = 0;
         for(auto &l : f.lines) {
-            logger::def->_line_no = l._line_no;
+            log._line_no = l._line_no;
             if (l._instr != nullptr) {
                 if (l._instr->_kind == instr_kind::BASE) {
                     l._instr.reset();
@@ -569,7 +570,7 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
                         }
                     }
                     else {
-                        logger::def->log("Unable to determine an address");
+                        log.log("Unable to determine an address");
                         return false;
                     }
                 }
@@ -579,12 +580,12 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
 
     // Now all labels should be resolved - so we can update all expressions
     for(auto &f : files) {
-        logger::def->_filename = f.filename;
-        logger::def->_line_no = 0;
+        log._filename = f.filename;
+        log._line_no = 0;
         for(auto &l : f.lines) {
-            logger::def->_line_no = l._line_no;
+            log._line_no = l._line_no;
             if (l._instr != nullptr) {
-                evaluator eval(labels);
+                evaluator eval(labels, log);
                 if (l._instr->_kind == instr_kind::DATA) {
                     l._instr->_parameter->accept(&eval);
                 }
@@ -597,21 +598,21 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
                     l._instr->_addressing_mode_parameter->accept(&eval);
                 }
                 if (eval._value.first != eval._value.second) {
-                    logger::def->log("Could not determine a value for the expression");
+                    log.log("Could not determine a value for the expression");
                     return false;
                 }
                 if (is_branch_instr(l._instr->_kind)) {
                     // We have a signed parameter - must be 8 bit signed - find the relative value
                     __int64_t rel = eval._value.first - l._instr->_address - 2; // -2 for the pc moving 2 bytes
                     if (rel < -128 || rel > 127) {
-                        logger::def->log("The expression value is out of range");
+                        log.log("The expression value is out of range");
                         return false;
                     }
                     l._instr->_binary_representation.push_back(rel & 0xFF);
                     continue;
                 }
                 if (eval._value.first < 0 || eval._value.first > 0xFFFF) {
-                    logger::def->log("The expression value is out of range");
+                    log.log("The expression value is out of range");
                     return false;
                 }
                 if (l._instr->_kind == instr_kind::DATA) {
@@ -633,7 +634,7 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
                     }
                     else {
                         // not ok
-                        logger::def->log("Instruction expects a single byte as parameter while the parameter is out of range");
+                        log.log("Instruction expects a single byte as parameter while the parameter is out of range");
                         return false;
                     }
                 }
@@ -647,16 +648,16 @@ bool tryLayout(std::vector<file> &files, REG16 &startAddress)
     }
 
     if (start != nullptr) {
-        evaluator seval(labels);
+        evaluator seval(labels, log);
         start->accept(&seval);
         if (seval._value.first != seval._value.second) {
-            logger::def->log("Could not find a value for the start address");
+            log.log("Could not find a value for the start address");
             return false;
         }
         startAddress = seval._value.first;
     }
     else {
-        logger::def->log("No 'START' instruction found");
+        log.log("No 'START' instruction found");
         return false;
     }
 
@@ -8,7 +8,9 @@
 
 namespace dave
 {
-    bool tryLayout(std::vector<file> &files, REG16 &startAddress);
+    class logger;
+
+    bool tryLayout(std::vector<file> &files, REG16 &startAddress, logger &log);
 }
 
 #endif
\ No newline at end of file
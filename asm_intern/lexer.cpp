@@ -35,7 +35,7 @@ void readIdentifier(const char **p, std::string &res) {
     }
 }
 
-bool tryReadHexLit(const char **p, token &tkn)
+bool tryReadHexLit(const char **p, token &tkn, logger &log)
 {
     std::string chars;
     while((**p >= '0' && **p <= '9') || (**p >= 'a' && **p <= 'f') || (**p >= 'A' && **p <= 'F')) {
@@ -51,13 +51,13 @@ bool tryReadHexLit(const char **p, token &tkn)
         tkn._w = std::strtoul(chars.c_str(), 0, 16);
     }
     else {
-        logger::def->log("Invalid size of hex literal. Expected 2 or 4 characters");
+        log.log("Invalid size of hex literal. Expected 2 or 4 characters");
         return false;
     }
     return true;
 }
 
-bool tryLexicalAnalysis(const std::string &text, std::vector<token> &tokens)
+bool tryLexicalAnalysis(const std::string &text, std::vector<token> &tokens, logger &log)
 {
     const char *p = text.c_str();
     while(*p != 0) {
@@ -125,7 +125,7 @@ bool tryLexicalAnalysis(const std::string &text, std::vector<token> &tokens)
                 if (true) {
                     p++;
                     tokens.emplace_back();
-                    if (!tryReadHexLit(&p, tokens.back())) {
+                    if (!tryReadHexLit(&p, tokens.back(), log)) {
                         return false;
                     }
                 }
@@ -154,7 +154,7 @@ bool tryLexicalAnalysis(const std::string &text, std::vector<token> &tokens)
                     }
                 }
                 else {
-                    logger::def->log() << "Syntax error. Unexpected character '" << *p << "'." << end();
+                    log.log() << "Syntax error. Unexpected character '" << *p << "'." << end();
                     return false;
                 }
         }
@@ -8,6 +8,8 @@
 
 namespace dave
 {
+    class logger;
+
     enum class token_kind
     {
         tk_constant, // %..
@@ -37,7 +39,7 @@ namespace dave
 
     auto operator << (std::ostream &os, const token &tkn) -> std::ostream&;
 
-    bool tryLexicalAnalysis(const std::string &text, std::vector<token> &tokens);
+    bool tryLexicalAnalysis(const std::string &text, std::vector<token> &tokens, logger &log);
 }
 
 #endif
\ No newline at end of file
@@ -3,8 +3,6 @@
 namespace dave
 {
 
-logger *logger::def;
-
 log_stream::log_stream(logger *logger)
 : _logger(logger)
 {
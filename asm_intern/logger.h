@@ -59,8 +59,6 @@ namespace dave
         }
 
         friend class log_stream;
-
-        static logger* def;
     };
 
     class stm_logger : public logger {
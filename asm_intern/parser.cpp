@@ -19,68 +19,68 @@ struct instr_traits {
 
 bool try_get_instr_traits(const std::string &code, instr_traits &t)
 {
-    static std::unordered_map<std::string, instr_traits> itraits;
-    if (itraits.empty()) {
-        itraits.emplace("BASE", instr_traits { instr_kind::BASE, true });
-        itraits.emplace("START", instr_traits { instr_kind::START, true });
-        itraits.emplace("DATA", instr_traits { instr_kind::DATA, true });
-        itraits.emplace("BRK", instr_traits { instr_kind::BRK, false });
-        itraits.emplace("ADC", instr_traits { instr_kind::ADC, true });
-        itraits.emplace("SBC", instr_traits { instr_kind::SBC, true });
-        itraits.emplace("AND", instr_traits { instr_kind::AND, true });
-        itraits.emplace("ASL", instr_traits { instr_kind::ASL, true });
-        itraits.emplace("BCC", instr_traits { instr_kind::BCC, true });
-        itraits.emplace("BCS", instr_traits { instr_kind::BCS, true });
-        itraits.emplace("BEQ", instr_traits { instr_kind::BEQ, true });
-        itraits.emplace("BMI", instr_traits { instr_kind::BMI, true });
-        itraits.emplace("BNE", instr_traits { instr_kind::BNE, true });
-        itraits.emplace("BPL", instr_traits { instr_kind::BPL, true });
-        itraits.emplace("BRA", instr_traits { instr_kind::BRA, true });
-        itraits.emplace("BVC", instr_traits { instr_kind::BVC, true });
-        itraits.emplace("BVS", instr_traits { instr_kind::BVS, true });
-        itraits.emplace("BIT", instr_traits { instr_kind::BIT, true });
-        itraits.emplace("CLC", instr_traits { instr_kind::CLC, false });
-        itraits.emplace("CLD", instr_traits { instr_kind::CLD, false });
-        itraits.emplace("CLI", instr_traits { instr_kind::CLI, false });
-        itraits.emplace("CLV", instr_traits { instr_kind::CLV, false });
-        itraits.emplace("SEC", instr_traits { instr_kind::SEC, false });
-        itraits.emplace("SED", instr_traits { instr_kind::SED, false });
-        itraits.emplace("SEI", instr_traits { instr_kind::SEI, false });
-        itraits.emplace("CMP", instr_traits { instr_kind::CMP, true });
-        itraits.emplace("CPX", instr_traits { instr_kind::CPX, true });
-        itraits.emplace("CPY", instr_traits { instr_kind::CPY, true });
-        itraits.emplace("DEC", instr_traits { instr_kind::DEC, true });
-        itraits.emplace("INC", instr_traits { instr_kind::INC, true });
-        itraits.emplace("EOR", instr_traits { instr_kind::EOR, true });
-        itraits.emplace("JMP", instr_traits { instr_kind::JMP, true });
-        itraits.emplace("JSR", instr_traits { instr_kind::JSR, true });
-        itraits.emplace("LDA", instr_traits { instr_kind::LDA, true });
-        itraits.emplace("LDX", instr_traits { instr_kind::LDX, true });
-        itraits.emplace("LDY", instr_traits { instr_kind::LDY, true });
-        itraits.emplace("LSR", instr_traits { instr_kind::LSR, true });
-        itraits.emplace("NOP", instr_traits { instr_kind::NOP, false });
-        itraits.emplace("OR", instr_traits { instr_kind::OR, true });
-        itraits.emplace("PHA", instr_traits { instr_kind::PHA, false });
-        itraits.emplace("PHP", instr_traits { instr_kind::PHP, false });
-        itraits.emplace("PHX", instr_traits { instr_kind::PHX, false });
-        itraits.emplace("PLA", instr_traits { instr_kind::PLA, false });
-        itraits.emplace("PLP", instr_traits { instr_kind::PLP, false });
-        itraits.emplace("PLX", instr_traits { instr_kind::PLX, false });
-        itraits.emplace("PLY", instr_traits { instr_kind::PLY, false });
-        itraits.emplace("ROL", instr_traits { instr_kind::ROL, true });
-        itraits.emplace("RTI", instr_traits { instr_kind::RTI, false });
-        itraits.emplace("RTS", instr_traits { instr_kind::RTS, false });
-        itraits.emplace("ROR", instr_traits { instr_kind::ROR, true });
-        itraits.emplace("STA", instr_traits { instr_kind::STA, true });
-        itraits.emplace("STY", instr_traits { instr_kind::STY, true });
-        itraits.emplace("STX", instr_traits { instr_kind::STX, true });
-        itraits.emplace("TAX", instr_traits { instr_kind::TAX, false });
-        itraits.emplace("TXA", instr_traits { instr_kind::TXA, false });
-        itraits.emplace("TAY", instr_traits { instr_kind::TAY, false });
-        itraits.emplace("TYA", instr_traits { instr_kind::TYA, false });
-        itraits.emplace("TSX", instr_traits { instr_kind::TSX, false });
-        itraits.emplace("TXS", instr_traits { instr_kind::TXS, false });
-    }
+    // Built once, before any caller can see it, so parsers on different threads can share it
+    static const std::unordered_map<std::string, instr_traits> itraits {
+        { "BASE", instr_traits { instr_kind::BASE, true } },
+        { "START", instr_traits { instr_kind::START, true } },
+        { "DATA", instr_traits { instr_kind::DATA, true } },
+        { "BRK", instr_traits { instr_kind::BRK, false } },
+        { "ADC", instr_traits { instr_kind::ADC, true } },
+        { "SBC", instr_traits { instr_kind::SBC, true } },
+        { "AND", instr_traits { instr_kind::AND, true } },
+        { "ASL", instr_traits { instr_kind::ASL, true } },
+        { "BCC", instr_traits { instr_kind::BCC, true } },
+        { "BCS", instr_traits { instr_kind::BCS, true } },
+        { "BEQ", instr_traits { instr_kind::BEQ, true } },
+        { "BMI", instr_traits { instr_kind::BMI, true } },
+        { "BNE", instr_traits { instr_kind::BNE, true } },
+        { "BPL", instr_traits { instr_kind::BPL, true } },
+        { "BRA", instr_traits { instr_kind::BRA, true } },
+        { "BVC", instr_traits { instr_kind::BVC, true } },
+        { "BVS", instr_traits { instr_kind::BVS, true } },
+        { "BIT", instr_traits { instr_kind::BIT, true } },
+        { "CLC", instr_traits { instr_kind::CLC, false } },
+        { "CLD", instr_traits { instr_kind::CLD, false } },
+        { "CLI", instr_traits { instr_kind::CLI, false } },
+        { "CLV", instr_traits { instr_kind::CLV, false } },
+        { "SEC", instr_traits { instr_kind::SEC, false } },
+        { "SED", instr_traits { instr_kind::SED, false } },
+        { "SEI", instr_traits { instr_kind::SEI, false } },
+        { "CMP", instr_traits { instr_kind::CMP, true } },
+        { "CPX", instr_traits { instr_kind::CPX, true } },
+        { "CPY", instr_traits { instr_kind::CPY, true } },
+        { "DEC", instr_traits { instr_kind::DEC, true } },
+        { "INC", instr_traits { instr_kind::INC, true } },
+        { "EOR", instr_traits { instr_kind::EOR, true } },
+        { "JMP", instr_traits { instr_kind::JMP, true } },
+        { "JSR", instr_traits { instr_kind::JSR, true } },
+        { "LDA", instr_traits { instr_kind::LDA, true } },
+        { "LDX", instr_traits { instr_kind::LDX, true } },
+        { "LDY", instr_traits { instr_kind::LDY, true } },
+        { "LSR", instr_traits { instr_kind::LSR, true } },
+        { "NOP", instr_traits { instr_kind::NOP, false } },
+        { "OR", instr_traits { instr_kind::OR, true } },
+        { "PHA", instr_traits { instr_kind::PHA, false } },
+        { "PHP", instr_traits { instr_kind::PHP, false } },
+        { "PHX", instr_traits { instr_kind::PHX, false } },
+        { "PLA", instr_traits { instr_kind::PLA, false } },
+        { "PLP", instr_traits { instr_kind::PLP, false } },
+        { "PLX", instr_traits { instr_kind::PLX, false } },
+        { "PLY", instr_traits { instr_kind::PLY, false } },
+        { "ROL", instr_traits { instr_kind::ROL, true } },
+        { "RTI", instr_traits { instr_kind::RTI, false } },
+        { "RTS", instr_traits { instr_kind::RTS, false } },
+        { "ROR", instr_traits { instr_kind::ROR, true } },
+        { "STA", instr_traits { instr_kind::STA, true } },
+        { "STY", instr_traits { instr_kind::STY, true } },
+        { "STX", instr_traits { instr_kind::STX, true } },
+        { "TAX", instr_traits { instr_kind::TAX, false } },
+        { "TXA", instr_traits { instr_kind::TXA, false } },
+        { "TAY", instr_traits { instr_kind::TAY, false } },
+        { "TYA", instr_traits { instr_kind::TYA, false } },
+        { "TSX", instr_traits { instr_kind::TSX, false } },
+        { "TXS", instr_traits { instr_kind::TXS, false } }
+    };
     auto f = itraits.find(code);
     if (f == itraits.end()) {
         return false;
@@ -91,9 +91,9 @@ bool try_get_instr_traits(const std::string &code, instr_traits &t)
     }
 };
 
-bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::shared_ptr<expression> &expr, const constants_t &constants);
+bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::shared_ptr<expression> &expr, const constants_t &constants, logger &log);
 
-bool tryParseSimpleExpression(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::shared_ptr<expression> &expr, const constants_t &constants)
+bool tryParseSimpleExpression(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::shared_ptr<expression> &expr, const constants_t &constants, logger &log)
 {
     if (it == end) {
         return false;
@@ -102,7 +102,7 @@ bool tryParseSimpleExpression(std::vector<token>::const_iterator &it, const std:
     switch(tkn.kind) {
         case token_kind::tk_hash:
             ++it;
-            if (!tryParseExpression(it, end, expr, constants)) return false;
+            if (!tryParseExpression(it, end, expr, constants, log)) return false;
             expr.reset(new addr_expression(expr));
             break;
         case token_kind::tk_lit_value:
@@ -114,7 +114,7 @@ bool tryParseSimpleExpression(std::vector<token>::const_iterator &it, const std:
             if (true) {
                 auto f = constants.find(it->_t);
                 if (f == constants.end()) {
-                    logger::def->log() << "The constant '" << it->_t << "' was not defined" << dave::end();
+                    log.log() << "The constant '" << it->_t << "' was not defined" << dave::end();
                     return false;
                 }
                 else {
@@ -143,24 +143,24 @@ bool tryParseSimpleExpression(std::vector<token>::const_iterator &it, const std:
             if (true) {
                 std::string name = it->_t;
                 if (name != "lo" && name != "hi") {
-                    logger::def->log() << "Unsupported function '" << name << "'" << dave::end();
+                    log.log() << "Unsupported function '" << name << "'" << dave::end();
                     return false;
                 }
                 ++it;
-                if (!tryParseExpression(it, end, expr, constants)) return false;
+                if (!tryParseExpression(it, end, expr, constants, log)) return false;
                 expr.reset(new func_expression(name, expr));
             }
             break;
         case token_kind::tk_open_paren:
             ++it;
             if (it == end) {
-                logger::def->log("Unexpected end-of-line");
+                log.log("Unexpected end-of-line");
                 return false;
             }
             // Precedence
-            if (!tryParseExpression(it, end, expr, constants)) return false;
+            if (!tryParseExpression(it, end, expr, constants, log)) return false;
             if (it == end || it->kind != token_kind::tk_close_paren) {
-                logger::def->log("Expected a ')'");
+                log.log("Expected a ')'");
                 return false;
             }
             ++it;
@@ -168,26 +168,26 @@ bool tryParseSimpleExpression(std::vector<token>::const_iterator &it, const std:
         case token_kind::tk_open_bracket:
             ++it;
             if (it == end) {
-                logger::def->log("Unexpected end-of-line");
+                log.log("Unexpected end-of-line");
                 return false;
             }
-            if (!tryParseExpression(it, end, expr, constants)) return false;
+            if (!tryParseExpression(it, end, expr, constants, log)) return false;
             if (it == end || it->kind != token_kind::tk_close_bracket) {
-                logger::def->log("Expected a ']'");
+                log.log("Expected a ']'");
                 return false;
             }
             ++it;
             expr.reset(new indirect_addr_expression(expr));
             break;
         default:
-            logger::def->log() << "Syntax error. Unexpected token '" << tkn << '\'' << dave::end();
+            log.log() << "Syntax error. Unexpected token '" << tkn << '\'' << dave::end();
             return false;
     }
 
     return true;
 }
 
-bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::shared_ptr<expression> &expr, const constants_t &constants)
+bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::shared_ptr<expression> &expr, const constants_t &constants, logger &log)
 {
     // We've just read an expression, now check the follow
     // We can have
@@ -201,7 +201,7 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
     // [exp] * <exp> - : reduce
     // [exp] * <exp> * : reduce
 
-    if (!tryParseSimpleExpression(it, end, expr, constants)) return false;
+    if (!tryParseSimpleExpression(it, end, expr, constants, log)) return false;
     // [exp] ?
     //       ^
     while(it != end) {
@@ -215,10 +215,10 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
                 // [exp] + <exp>
                 //         ^
                 if (it == end) {
-                    logger::def->log("Unexpected end-of-line");
+                    log.log("Unexpected end-of-line");
                     return false;
                 }
-                if (!tryParseSimpleExpression(it, end, rhs, constants)) return false;
+                if (!tryParseSimpleExpression(it, end, rhs, constants, log)) return false;
                 // [exp] + <exp> *
                 //               ^
                 while(it != end && it->kind == token_kind::tk_asterisk) {
@@ -226,7 +226,7 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
                     // [exp] + <exp> * <x>
                     //                 ^
                     std::shared_ptr<expression> x;
-                    if (!tryParseSimpleExpression(it, end, x, constants)) return false;
+                    if (!tryParseSimpleExpression(it, end, x, constants, log)) return false;
                     // [exp] + <exp> * <x> ?
                     //                     ^
                     rhs.reset(new multiply_expression(rhs, x));
@@ -240,10 +240,10 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
                 // [exp] - <exp>
                 //         ^
                 if (it == end) {
-                    logger::def->log("Unexpected end-of-line");
+                    log.log("Unexpected end-of-line");
                     return false;
                 }
-                if (!tryParseSimpleExpression(it, end, rhs, constants)) return false;
+                if (!tryParseSimpleExpression(it, end, rhs, constants, log)) return false;
                 // [exp] - <exp> *
                 //               ^
                 while(it != end && it->kind == token_kind::tk_asterisk) {
@@ -251,7 +251,7 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
                     // [exp] - <exp> * <x>
                     //                 ^
                     std::shared_ptr<expression> x;
-                    if (!tryParseSimpleExpression(it, end, x, constants)) return false;
+                    if (!tryParseSimpleExpression(it, end, x, constants, log)) return false;
                     // [exp] - <exp> * <x> ?
                     //                     ^
                     rhs.reset(new multiply_expression(rhs, x));
@@ -265,17 +265,17 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
                 // [exp] * <exp>
                 //         ^
                 if (it == end) {
-                    logger::def->log("Unexpected end-of-line");
+                    log.log("Unexpected end-of-line");
                     return false;
                 }
-                if (!tryParseSimpleExpression(it, end, rhs, constants)) return false;
+                if (!tryParseSimpleExpression(it, end, rhs, constants, log)) return false;
                 expr.reset(new multiply_expression(expr, rhs));
                 break;
             case token_kind::tk_close_bracket:
             case token_kind::tk_close_paren:
                 return true;
             default:
-                logger::def->log() << "Syntax error. Unexpected token '" << tkn << '\'' << dave::end();
+                log.log() << "Syntax error. Unexpected token '" << tkn << '\'' << dave::end();
                 return false;
         }
     }
@@ -283,7 +283,7 @@ bool tryParseExpression(std::vector<token>::const_iterator &it, const std::vecto
     return true;
 }
 
-bool tryParseConstAssign(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, constants_t &constants)
+bool tryParseConstAssign(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, constants_t &constants, logger &log)
 {
     // 'it' is pointing at the constant name
     std::string name;
@@ -291,21 +291,21 @@ bool tryParseConstAssign(std::vector<token>::const_iterator &it, const std::vect
 
     ++it;
     if (it == end) {
-        logger::def->log("Unexpected end-of-line");
+        log.log("Unexpected end-of-line");
         return false;
     }
     else if (it->kind != token_kind::tk_eq) {
-        logger::def->log("Expected an '='");
+        log.log("Expected an '='");
         return false;
     }
     ++it;
     if (it == end) {
-        logger::def->log("Unexpected end-of-line");
+        log.log("Unexpected end-of-line");
         return false;
     }
     else {
         std::shared_ptr<expression> exp;
-        if (!tryParseExpression(it, end, exp, constants)) {
+        if (!tryParseExpression(it, end, exp, constants, log)) {
             return false;
         }
 
@@ -316,7 +316,7 @@ bool tryParseConstAssign(std::vector<token>::const_iterator &it, const std::vect
     }
 }
 
-bool tryParseInstr(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::unique_ptr<instr> &instr, const constants_t &constants)
+bool tryParseInstr(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::unique_ptr<instr> &instr, const constants_t &constants, logger &log)
 {
     // 'it' is pointing to the instruction
     instr.reset(new dave::instr());
@@ -324,7 +324,7 @@ bool tryParseInstr(std::vector<token>::const_iterator &it, const std::vector<tok
     // Decode the code
     instr_traits itraits;
     if (!try_get_instr_traits(instr->_code, itraits)) {
-        logger::def->log() << " - The instruction '" << instr->_code << "' was not recognised" << dave::end();
+        log.log() << " - The instruction '" << instr->_code << "' was not recognised" << dave::end();
         return false;
     }
     instr->_kind = itraits.kind;
@@ -332,17 +332,17 @@ bool tryParseInstr(std::vector<token>::const_iterator &it, const std::vector<tok
     ++it;
     if (it == end) {
         if (itraits.has_parameter) {
-            logger::def->log() << " - The instruction '" << instr->_code << "' requires a parameter" << dave::end();
+            log.log() << " - The instruction '" << instr->_code << "' requires a parameter" << dave::end();
             return false;
         }
         return true;
     }
     else {
         if (!itraits.has_parameter) {
-            logger::def->log() << " - The instruction '" << instr->_code << "' does not expect a parameter" << dave::end();
+            log.log() << " - The instruction '" << instr->_code << "' does not expect a parameter" << dave::end();
             return false;
         }
-        if (!tryParseExpression(it, end, instr->_parameter, constants)) {
+        if (!tryParseExpression(it, end, instr->_parameter, constants, log)) {
             return false;
         }
 
@@ -350,7 +350,7 @@ bool tryParseInstr(std::vector<token>::const_iterator &it, const std::vector<tok
     }
 }
 
-bool tryParseInstruction(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::unique_ptr<instr> &instr, constants_t &constants, std::string &current_label)
+bool tryParseInstruction(std::vector<token>::const_iterator &it, const std::vector<token>::const_iterator &end, std::unique_ptr<instr> &instr, constants_t &constants, std::string &current_label, logger &log)
 {
     if (it == end) {
         return true;
@@ -362,33 +362,33 @@ bool tryParseInstruction(std::vector<token>::const_iterator &it, const std::vect
             current_label = it->_t;
             ++it;
             if (it == end || it->kind != token_kind::tk_colon) {
-                logger::def->log("Expected ':'");
+                log.log("Expected ':'");
                 return false;
             }
             ++it;
             if (it != end) {
-                ok = tryParseInstruction(it, end, instr, constants, current_label);
+                ok = tryParseInstruction(it, end, instr, constants, current_label, log);
             }
             break;
         case token_kind::tk_constant:
-            ok = tryParseConstAssign(it, end, constants);
+            ok = tryParseConstAssign(it, end, constants, log);
             break;
         case token_kind::tk_identifier:
-            ok = tryParseInstr(it, end, instr, constants);
+            ok = tryParseInstr(it, end, instr, constants, log);
             instr->_label = current_label;
             current_label.clear();
             break;
         default:
-            logger::def->log() << " - Unexpected token '" << tkn << "'. Expected 'label', 'type' or 'instruction'." << dave::end();
+            log.log() << " - Unexpected token '" << tkn << "'. Expected 'label', 'type' or 'instruction'." << dave::end();
             return false;
     }
 
     return ok;
 }
 
-bool tryParse(file &f)
+bool tryParse(file &f, logger &log)
 {
-    logger::def->_filename = f.filename;
+    log._filename = f.filename;
 
     int line_no = 0;
     char line[1024];
@@ -398,25 +398,25 @@ bool tryParse(file &f)
 
     std::ifstream source(f.filename);
     if (!source) {
-        logger::def->log("Unable to open the file for input");
+        log.log("Unable to open the file for input");
         return false;
     }
 
     while(!source.eof()) {
         line_no++;
-        logger::def->_line_no = line_no;
+        log._line_no = line_no;
         char line[1024];
         source.getline(line, 1023);
         f.lines.emplace_back();
         f.lines.back()._line_no = line_no;
         f.lines.back()._text = line;
         std::vector<token> tokens;
-        if (!tryLexicalAnalysis(f.lines.back()._text, tokens)) {
+        if (!tryLexicalAnalysis(f.lines.back()._text, tokens, log)) {
             return false;
         }
         if (tokens.empty()) continue;
         auto it = tokens.cbegin();
-        if (!tryParseInstruction(it, tokens.cend(), f.lines.back()._instr, constants, current_label)) {
+        if (!tryParseInstruction(it, tokens.cend(), f.lines.back()._instr, constants, current_label, log)) {
             return false;
         }
     }
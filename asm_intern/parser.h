@@ -8,7 +8,9 @@
 
 namespace dave
 {
-    bool tryParse(file &f);
+    class logger;
+
+    bool tryParse(file &f, logger &log);
 }
 
 #endif
\ No newline at end of file
@@ -30,9 +30,25 @@ void write_byte(std::ostream &output, REG8 byte, REG16 addr) {
     output << " ; 0x" << std::setfill('0') << std::hex << std::uppercase << std::setw(2) << (int)byte;
 }
 
-bool pc_code_generator::try_generate(const std::vector<file> &files, const REG16 startAddress)
+// Write the card lines, with the address of every data byte from 'addr' on
+void write_lines(std::ostream &output, const std::vector<card_line> &lines, REG16 addr) {
+    static const char *holes[] = { "_ _ ", "_ O ", "O _ ", "O O " };
+    for(auto &l : lines) {
+        output << holes[l.first & 0x03];
+        if (l.first == 1) {
+            write_byte(output, l.second, addr++);
+        }
+        else {
+            write_byte(output, l.second, 0);
+        }
+        output << std::endl;
+    }
+}
+
+bool pc_code_generator::try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log)
 {
     REG16 cur = 0;
+    std::vector<card_line> lines;
     for(auto &f : files) {
         _output << "; " << f.filename << std::endl;
         for(auto &l : f.lines) {
@@ -41,31 +57,18 @@ bool pc_code_generator::try_generate(const std::vector<file> &files, const REG16
                 REG16 addr = l._instr->_address;
                 if (addr != cur) {
                     _output << "; Change address to 0x" << std::setfill('0') << std::hex << std::uppercase << std::setw(4) << addr << std::endl;
-                    _output << "O _ ";
-                    write_byte(_output, addr & 0xFF, 0);
-                    _output << std::endl;
-                    _output << "O O ";
-                    write_byte(_output, addr >> 8, 0);
-                    _output << std::endl;
-                }
-                for(auto &i : l._instr->_binary_representation) {
-                    _output << "_ O ";
-                    write_byte(_output, i, addr);
-                    _output << std::endl;
-                    addr++;
                 }
-                cur = addr;
+                lines.clear();
+                append_card_lines(*l._instr, cur, lines);
+                write_lines(_output, lines, addr);
             }
         }
     }
     // Goto start address
     _output << "; Execute start address" << std::endl;
-    _output << "O _ ";
-    write_byte(_output, startAddress & 0xFF, 0);
-    _output << std::endl;
-    _output << "O O ";
-    write_byte(_output, startAddress >> 8, 0);
-    _output << std::endl;
+    lines.clear();
+    append_start_lines(startAddress, lines);
+    write_lines(_output, lines, 0);
     return true;
 }
 
@@ -20,7 +20,7 @@ namespace dave
         auto operator =(const pc_code_generator&) -> pc_code_generator& = delete;
         auto operator =(pc_code_generator&&) -> pc_code_generator& = delete;
 
-        virtual bool try_generate(const std::vector<file> &files, const REG16 startAddress) override;
+        virtual bool try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log) override;
     };
 }
 
@@ -0,0 +1,49 @@
+#include "pcb_code_generator.h"
+
+namespace dave
+{
+
+pcb_code_generator::pcb_code_generator(std::ostream &output)
+: _output(output)
+{
+}
+
+pcb_code_generator::~pcb_code_generator()
+{}
+
+bool pcb_code_generator::try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log)
+{
+    // Same lines as the punch card text
+    std::vector<card_line> lines;
+    REG16 cur = 0;
+    for(auto &f : files) {
+        for(auto &l : f.lines) {
+            if (l._instr != nullptr) {
+                append_card_lines(*l._instr, cur, lines);
+            }
+        }
+    }
+    append_start_lines(startAddress, lines);
+
+    std::vector<REG8> deck = { 'X', 'P', 'C', 'B' };
+    for(size_t i = 0; i < 4; i++) {
+        deck.push_back((REG8)(lines.size() >> (i * 8)));
+    }
+    unsigned int acc = 0;
+    size_t bits = 0;
+    for(auto &l : lines) {
+        acc = (acc << 10) | ((unsigned int)(l.first & 0x03) << 8) | l.second;
+        bits += 10;
+        while(bits >= 8) {
+            bits -= 8;
+            deck.push_back((REG8)(acc >> bits));
+        }
+    }
+    if (bits != 0) {
+        deck.push_back((REG8)(acc << (8 - bits)));
+    }
+    _output.write((const char*)deck.data(), deck.size());
+    return (bool)_output;
+}
+
+}
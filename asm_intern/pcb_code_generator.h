@@ -0,0 +1,30 @@
+#ifndef __PCB_CODE_GENERATORH
+#define __PCB_CODE_GENERATORH
+
+#include "code_generator.h"
+#include <ostream>
+
+namespace dave
+{
+    // Writes the punch card as a packed binary deck. The header is "XPCB" followed by the number of
+    // lines (4 bytes, lo byte first). Each line is 10 bits (2 instruction bits, then 8 data bits), and
+    // the lines are packed together from the high bit of the first byte down.
+    class pcb_code_generator : public code_generator {
+    private:
+        std::ostream &_output;
+    public:
+        pcb_code_generator() = delete;
+        pcb_code_generator(const pcb_code_generator&) = delete;
+        pcb_code_generator(pcb_code_generator&&) = delete;
+        explicit pcb_code_generator(std::ostream &output);
+
+        virtual ~pcb_code_generator();
+
+        auto operator =(const pcb_code_generator&) -> pcb_code_generator& = delete;
+        auto operator =(pcb_code_generator&&) -> pcb_code_generator& = delete;
+
+        virtual bool try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log) override;
+    };
+}
+
+#endif
@@ -14,7 +14,7 @@ rom_code_generator::rom_code_generator(std::ostream &output)
 rom_code_generator::~rom_code_generator()
 {}
 
-bool rom_code_generator::try_generate(const std::vector<file> &files, const REG16 startAddress)
+bool rom_code_generator::try_generate(const std::vector<file> &files, const REG16 startAddress, logger &log)
 {
     _output << "template<typename TRom> void initialize_kernel_rom(TRom *rom)" << std::endl;
     _output << '{' << std::endl;
@@ -0,0 +1,51 @@
+; Runs every form of JMP [..]: through a pointer in page zero or anywhere, and through a table in page zero or anywhere,
+; indexed by X. Every jump lands on the next step. The byte after a jump is a NOP, rather than a $00 that makes a
+; zero page pointer encoded in a single byte look right. The deck ends in the loop at @done, which
+; software/golden/regress.jobs halts on; a jump that goes wrong never gets there.
+%base = #$0200
+%zpPointer = #$20
+%zpTable = #$22
+%absPointer = #$0300
+%absTable = #$0310
+
+START %base
+
+BASE %base
+; JMP [zp]
+LDA lo(@step2)
+STA %zpPointer
+LDA hi(@step2)
+STA %zpPointer + $01
+JMP [%zpPointer]
+NOP
+
+@step2:
+; JMP [abs]
+LDA lo(@step3)
+STA %absPointer
+LDA hi(@step3)
+STA %absPointer + $01
+JMP [%absPointer]
+NOP
+
+@step3:
+; JMP [zp + X], the second entry of the table
+LDA lo(@step4)
+STA %zpTable + $02
+LDA hi(@step4)
+STA %zpTable + $03
+LDX $02
+JMP [%zpTable + X]
+NOP
+
+@step4:
+; JMP [abs + X], the second entry of the table
+LDA lo(@done)
+STA %absTable + $02
+LDA hi(@done)
+STA %absTable + $03
+LDX $02
+JMP [%absTable + X]
+NOP
+
+@done: JMP @done
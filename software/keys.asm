@@ -0,0 +1,23 @@
+; Types the keys of the job's key script (software/keys.txt) onto the screen. It polls the keyboard's status and data,
+; with the interupts off, until it read a '.'. The deck then ends in the loop at @done, which
+; software/golden/regress.jobs halts on.
+%base = #$0200
+%kbdData = #$D04E
+%kbdStatus = #$D04F
+%screen = #$0400
+%lastKey = $2E
+
+START %base
+
+BASE %base
+SEI
+LDY $00
+@wait: LDA %kbdStatus
+BEQ @wait
+LDA %kbdData
+STA %screen+Y
+INC Y
+CMP %lastKey
+BNE @wait
+
+@done: JMP @done
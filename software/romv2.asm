@@ -29,6 +29,7 @@
 
 ; Boot entry point
 BASE %bootEntry
+START %bootEntry
 
 ; Set stack pointer to $FF
 LDX $FF
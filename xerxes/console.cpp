@@ -56,13 +56,13 @@ void write_text(const std::string &text, int color = 0)
     }
 }
 
-void write_button(const std::string &text, bool value)
+void console::write_button(const std::string &text, bool value)
 {
     auto c = value ? COLOR_PAIR(3) : COLOR_PAIR(4);
     addch(' ' | c);
     write_text(text, c);
     addch(' ' | c);
-    console::reset_cursor();
+    reset_cursor();
 }
 
 void console::initialize()
@@ -367,11 +367,11 @@ int get_register_line(const std::string &name)
     else return 0;
 }
 
-template<typename T> void g_update_cpu_register(const std::string &name, const T &value)
+template<typename T> void console::update_register(const std::string &name, const T &value)
 {
     int line = get_register_line(name);
     if (line == 0) return;
-    static uint16_t prev_values[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    auto &prev_values = _prev_register_values;
 
     move(line, 50);
     std::stringstream stm;
@@ -391,22 +391,22 @@ template<typename T> void g_update_cpu_register(const std::string &name, const T
         }
     }
     
-    console::reset_cursor();
+    reset_cursor();
 }
 
 void console::update_cpu_register(const std::string &name, const bool &value)
 {
-    g_update_cpu_register<bool>(name, value);
+    update_register<bool>(name, value);
 }
 
 void console::update_cpu_register(const std::string &name, const uint8_t &value)
 {
-    g_update_cpu_register<uint8_t>(name, value);
+    update_register<uint8_t>(name, value);
 }
 
 void console::update_cpu_register(const std::string &name, const uint16_t &value)
 {
-    g_update_cpu_register<uint16_t>(name, value);
+    update_register<uint16_t>(name, value);
 }
 
 void console::update_char_on_virtual_monitor(const REG16 &addr, const REG8 &data)
@@ -419,13 +419,13 @@ void console::update_char_on_virtual_monitor(const REG16 &addr, const REG8 &data
     REG16 x = (addr % 40) + 1;
     move(y, x);
 
-    static char random_chars[] = { '!', '"', '%', '^', '&', '*', '(', ')', '+', '{', '}', '[', ']', '@', ':', ';', '~', '#', '<', '>', ',', '.' };
+    static const char random_chars[] = { '!', '"', '%', '^', '&', '*', '(', ')', '+', '{', '}', '[', ']', '@', ':', ';', '~', '#', '<', '>', ',', '.' };
 
     // Output the character at this memory address
     auto ch = data & 0x7F;
     int c = 7;
     if (!isprint(ch)) {
-        ch = random_chars[rand() % sizeof(random_chars)];
+        ch = random_chars[_noise() % sizeof(random_chars)];
     }
     addch(ch);
 }
@@ -479,11 +479,9 @@ void console::clear_alert()
     reset_cursor();
 }
 
-int bus_line = 0;
-
 void console::clear_bus()
 {
-    bus_line = 0;
+    _bus_line = 0;
     for(int line = 16; line < 26; line++) {
         move(line, 44);
         for(int col = 44; col < 67; col++) {
@@ -520,10 +518,10 @@ void write_addr(const REG16 &addr)
 
 void console::add_bus(const REG16 &addr, const REG8 *data)
 {
-    if (bus_line == 10) return;
-    move(bus_line + 16, 45);
+    if (_bus_line == 10) return;
+    move(_bus_line + 16, 45);
     write_data_addr(addr, *data);
-    bus_line++;
+    _bus_line++;
 }
 
 void console::report_pc(system_bus *bus, const REG16 &addr)
@@ -787,7 +785,7 @@ REG16 console::get_addr_from_input(const std::string &label)
         addch(' ');
         move(30,pos);
         
-        auto key = console::getkey();
+        auto key = getkey();
         switch(key) {
         case 127: // backspace
             if (index != 0) {
@@ -810,8 +808,6 @@ REG16 console::get_addr_from_input(const std::string &label)
     }
 }
 
-int next_watch_line = 16;
-
 void console::clear_watches()
 {
     for(int line = 16; line < 26; line++) {
@@ -820,20 +816,17 @@ void console::clear_watches()
             addch(' ');
         }
     }
-    next_watch_line = 16;
+    _next_watch_line = 16;
 }
 
 void console::add_watch(const REG16 &addr, const REG8 &cur_value, bool value_changed)
 {
-    if (next_watch_line == 25) return;
-    move(next_watch_line, 71);
-    next_watch_line++;
+    if (_next_watch_line == 25) return;
+    move(_next_watch_line, 71);
+    _next_watch_line++;
     write_data_addr(addr, cur_value, value_changed ? COLOR_PAIR(1) : 0);
 }
 
-int next_pc_break_line = 1;
-int next_bus_break_line = 16;
-
 void console::clear_breakpoints()
 {
     for(int line = 1; line < 14; line++) {
@@ -842,29 +835,29 @@ void console::clear_breakpoints()
             addch(' ');
         }
     }
-    next_pc_break_line = 1;
+    _next_pc_break_line = 1;
     for(int line = 16; line < 26; line++) {
         move(line, 91);
         for (int col = 91; col < 103; col++) {
             addch(' ');
         }
     }
-    next_bus_break_line = 16;
+    _next_bus_break_line = 16;
 }
 
 void console::add_bus_breakpoint(const REG16 &addr)
 {
-    if (next_bus_break_line == 25) return;
-    move(next_bus_break_line, 92);
-    next_bus_break_line++;
+    if (_next_bus_break_line == 25) return;
+    move(_next_bus_break_line, 92);
+    _next_bus_break_line++;
     write_addr(addr);
 }
 
 void console::add_pc_breakpoint(const REG16 &addr)
 {
-    if (next_pc_break_line == 13) return;
-    move(next_pc_break_line, 92);
-    next_pc_break_line++;
+    if (_next_pc_break_line == 13) return;
+    move(_next_pc_break_line, 92);
+    _next_pc_break_line++;
     write_addr(addr);
 }
 
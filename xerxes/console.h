@@ -1,54 +1,73 @@
 #ifndef __CONSOLEH
 #define __CONSOLEH
 
+#include <random>
 #include <string>
 #include "../xerxes_lib/common.h"
 #include "../xerxes_lib/system_bus.h"
 
 namespace dave
 {
+    // The curses UI of the emulator. All the state of the screen lives in the instance, which is handed
+    // to the debugger and the monitor device.
     class console {
+    private:
+        int _bus_line = 0;
+        int _next_watch_line = 16;
+        int _next_pc_break_line = 1;
+        int _next_bus_break_line = 16;
+        uint16_t _prev_register_values[13] = {};
+        std::minstd_rand _noise;
+
+        template<typename T> void update_register(const std::string &name, const T &value);
+        void write_button(const std::string &text, bool value);
     public:
-        static void initialize();
-        static void teardown();
+        console() = default;
+        console(const console&) = delete;
+        console(console &&) = delete;
+        auto operator =(const console&)->console& = delete;
+        auto operator =(console &&)->console& = delete;
+
+        void initialize();
+        void teardown();
 
-        static void reset_cursor();
-        static void draw_screen();
+        void reset_cursor();
+        void draw_screen();
 
-        static void update_cpu_register(const std::string &name, const bool &value);
-        static void update_cpu_register(const std::string &name, const uint8_t &value);
-        static void update_cpu_register(const std::string &name, const uint16_t &value);
+        void update_cpu_register(const std::string &name, const bool &value);
+        void update_cpu_register(const std::string &name, const uint8_t &value);
+        void update_cpu_register(const std::string &name, const uint16_t &value);
 
-        static int getkey();
-        static bool try_getkey(int &key);
+        int getkey();
+        bool try_getkey(int &key);
 
-        static void update_char_on_virtual_monitor(const REG16 &addr, const REG8 &data);
-        static void show_operation(const std::string &op);
-        static void update_ticks(const size_t ticks);
-        static void alert(const std::string &msg);
-        static void clear_alert();
+        void update_char_on_virtual_monitor(const REG16 &addr, const REG8 &data);
+        void show_operation(const std::string &op);
+        void update_ticks(const size_t ticks);
+        void alert(const std::string &msg);
+        void clear_alert();
 
-        static void clear_bus();
-        static void add_bus(const REG16 &addr, const REG8 *data);
+        void clear_bus();
+        void add_bus(const REG16 &addr, const REG8 *data);
 
-        static void report_pc(system_bus *bus, const REG16 &addr);
-        static void report_s(system_bus *bus, const REG8 &value);
+        void report_pc(system_bus *bus, const REG16 &addr);
+        void report_s(system_bus *bus, const REG8 &value);
 
-        static void update_nmi_line(bool value);
-        static void update_irq_line(bool value);
-        static void update_reset_line(bool value);
+        void update_nmi_line(bool value);
+        void update_irq_line(bool value);
+        void update_reset_line(bool value);
 
-        static REG16 get_addr_from_input(const std::string &label);
+        REG16 get_addr_from_input(const std::string &label);
 
-        static void clear_watches();
-        static void add_watch(const REG16 &addr, const REG8 &cur_value, bool value_changed);
+        void clear_watches();
+        void add_watch(const REG16 &addr, const REG8 &cur_value, bool value_changed);
 
-        static void clear_breakpoints();
-        static void add_bus_breakpoint(const REG16 &addr);
-        static void add_pc_breakpoint(const REG16 &addr);
+        void clear_breakpoints();
+        void add_bus_breakpoint(const REG16 &addr);
+        void add_pc_breakpoint(const REG16 &addr);
 
-        static void report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer);
-        static void set_break_config(bool break_on_nmi, bool break_on_irq, bool break_on_reset);
+        void report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer);
+        void set_break_config(bool break_on_nmi, bool break_on_irq, bool break_on_reset);
     };
 }
 
@@ -1,6 +1,7 @@
 #include "emulator_debugger.h"
 
-#include "console.h"
+#include <iomanip>
+#include <sstream>
 
 namespace dave
 {
@@ -24,32 +25,51 @@ bool emulator_debugger::break_after_instruction()
 
 bool emulator_debugger::break_on_reset()
 {
-    console::alert("reset");
+    _console.alert("reset");
     return _break_on_reset;
 }
 
 bool emulator_debugger::break_on_nmi()
 {
-    console::alert("nmi");
+    _console.alert("nmi");
     return _break_on_nmi;
 }
 
 bool emulator_debugger::break_on_interupt()
 {
-    console::alert("interupt");
+    _console.alert("interupt");
     return _break_on_interupt;
 }
 
 bool emulator_debugger::break_on_break()
 {
-    console::alert("break");
+    _console.alert("break");
     return _break_on_break;
 }
 
+bool emulator_debugger::break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode)
+{
+    std::ostringstream stm;
+    stm << "unknown opcode " << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << (unsigned int)opcode << " at " << std::setw(4) << addr;
+    _console.alert(stm.str());
+    return _break_on_unknown_opcode;
+}
+
+bool emulator_debugger::break_on_stop(const REG16 &addr)
+{
+    std::ostringstream stm;
+    stm << "stopped at " << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << addr << ", until reset";
+    _console.alert(stm.str());
+    return _break_on_stop;
+}
+
 bool emulator_debugger::break_asap()
 {
+    if (_typing != nullptr) {
+        return _typing->break_requested();
+    }
     int key;
-    if(console::try_getkey(key)) {
+    if(_console.try_getkey(key)) {
         return key == 'b';
     }
     else {
@@ -70,49 +90,49 @@ bool emulator_debugger::break_on_bus_address_changed(const REG16 &addr)
 
 void emulator_debugger::report_cpu_register(const std::string &name, const uint8_t &value)
 {
-    console::update_cpu_register(name, value);
+    _console.update_cpu_register(name, value);
     if (name == "S") {
-        console::report_s(_bus, value);
+        _console.report_s(_bus, value);
     }
 }
 
 void emulator_debugger::report_cpu_register(const std::string &name, const uint16_t &value)
 {
-    console::update_cpu_register(name, value);
+    _console.update_cpu_register(name, value);
     if (name == "PC") {
-        console::report_pc(_bus, value);
+        _console.report_pc(_bus, value);
     }
 }
 
 void emulator_debugger::report_cpu_register(const std::string &name, const bool &value)
 {
-    console::update_cpu_register(name, value);
+    _console.update_cpu_register(name, value);
 }
 
 void emulator_debugger::report_nmi_line(bool value)
 {
-    console::update_nmi_line(value);
+    _console.update_nmi_line(value);
 }
 
 void emulator_debugger::report_irq_line(bool value)
 {
-    console::update_irq_line(value);
+    _console.update_irq_line(value);
 }
 
 void emulator_debugger::report_reset_line(bool value)
 {
-    console::update_reset_line(value);
+    _console.update_reset_line(value);
 }
 
 void emulator_debugger::tick()
 {
     _ticks++;
-    console::update_ticks(_ticks);
+    _console.update_ticks(_ticks);
 }
 
 void emulator_debugger::report_address_write(const REG16 &addr, const REG8 *data)
 {
-    console::add_bus(addr, data);
+    _console.add_bus(addr, data);
 }
 
 void emulator_debugger::attach_system_bus(system_bus *bus)
@@ -140,16 +160,16 @@ void emulator_debugger::delete_watch(const REG16 &addr)
 }
 
 void emulator_debugger::refresh_watches() {
-    console::clear_watches();
+    _console.clear_watches();
     for(auto &m : _mem) {
         if (m.second.watch) {
             REG8 cur_value = 0;
             _bus->read(m.first, &cur_value);
-            console::add_watch(m.first, cur_value, cur_value != m.second.value);
+            _console.add_watch(m.first, cur_value, cur_value != m.second.value);
             m.second.value = cur_value;
         }
     }
-    console::reset_cursor();
+    _console.reset_cursor();
 }
 
 void emulator_debugger::add_pc_breakpoint(const REG16 &addr) {
@@ -181,41 +201,41 @@ void emulator_debugger::delete_bus_breakpoint(const REG16 &addr) {
 }
 
 void emulator_debugger::refresh_breakpoints() {
-    console::clear_breakpoints();
+    _console.clear_breakpoints();
     for(auto &m : _mem) {
         if (m.second.must_break) {
             REG8 cur_value = 0;
             _bus->read(m.first, &cur_value);
-            console::add_bus_breakpoint(m.first);
+            _console.add_bus_breakpoint(m.first);
         }
     }
     for(auto &p : _pc_breakpoints) {
-        console::add_pc_breakpoint(p);
+        _console.add_pc_breakpoint(p);
     }
-    console::reset_cursor();
+    _console.reset_cursor();
 }
 
 void emulator_debugger::report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer)
 {
-    console::report_punchcardreader_status(irqHigh, nextByteRequested, status, byteInBuffer);   
+    _console.report_punchcardreader_status(irqHigh, nextByteRequested, status, byteInBuffer);   
 }
 
 void emulator_debugger::toggle_break_on_nmi()
 {
     _break_on_nmi = !_break_on_nmi;
-    console::set_break_config(_break_on_nmi, _break_on_interupt, _break_on_reset);
+    _console.set_break_config(_break_on_nmi, _break_on_interupt, _break_on_reset);
 }
 
 void emulator_debugger::toggle_break_on_irq()
 {
     _break_on_interupt = !_break_on_interupt;
-    console::set_break_config(_break_on_nmi, _break_on_interupt, _break_on_reset);
+    _console.set_break_config(_break_on_nmi, _break_on_interupt, _break_on_reset);
 }
 
 void emulator_debugger::toggle_break_on_reset()
 {
     _break_on_reset = !_break_on_reset;
-    console::set_break_config(_break_on_nmi, _break_on_interupt, _break_on_reset);
+    _console.set_break_config(_break_on_nmi, _break_on_interupt, _break_on_reset);
 }
 
 }
\ No newline at end of file
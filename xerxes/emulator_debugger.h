@@ -4,6 +4,8 @@
 #include <map>
 #include <set>
 #include "../xerxes_lib/debugger.h"
+#include "../xerxes_lib/keyboard.h"
+#include "console.h"
 
 namespace dave
 {
@@ -21,13 +23,25 @@ namespace dave
         std::map<REG16, memory_info> _mem;
 
         REG16 _last_pc_broken = 0;
+        console &_console;
+        key_feeder *_typing = nullptr;
     public:
+        emulator_debugger(console &console)
+            : _console(console)
+        {}
+        emulator_debugger(const emulator_debugger&) = delete;
+        emulator_debugger(emulator_debugger &&) = delete;
+        auto operator =(const emulator_debugger&)->emulator_debugger& = delete;
+        auto operator =(emulator_debugger &&)->emulator_debugger& = delete;
+
         bool _break_on_started = true;
         bool _break_after_instruction = false;
         bool _break_on_reset = true;
         bool _break_on_nmi = true;
         bool _break_on_interupt = true;
         bool _break_on_break = true;
+        bool _break_on_unknown_opcode = true;
+        bool _break_on_stop = true;
 
         virtual void attach_system_bus(system_bus *bus) override;
 
@@ -38,6 +52,8 @@ namespace dave
         virtual bool break_on_nmi() override;
         virtual bool break_on_interupt() override;
         virtual bool break_on_break() override;
+        virtual bool break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode) override;
+        virtual bool break_on_stop(const REG16 &addr) override;
         virtual bool break_asap() override;
         virtual bool break_on_bus_address_changed(const REG16 &addr) override;
 
@@ -63,6 +79,9 @@ namespace dave
 
         virtual void report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer) override;
 
+        // While the console types on the emulated keyboard, its break key breaks, instead of 'b'
+        void typing(key_feeder *feeder) { _typing = feeder; }
+
         void toggle_break_on_nmi();
         void toggle_break_on_irq();
         void toggle_break_on_reset();
@@ -1,20 +1,22 @@
 #ifndef __MONITORH
 #define __MONITORH
 
-#include "../xerxes_lib/device.h"
+#include "../xerxes_lib/screen.h"
 #include "console.h"
 
 namespace dave
 {
-    template<REG16 addr_lower, REG16 addr_upper> class monitor : public device {
+    // The screen, projected onto the virtual monitor of the console
+    template<REG16 addr_lower, REG16 addr_upper> class monitor : public screen<addr_lower, addr_upper> {
     private:
-        REG8 _data[addr_upper - addr_lower + 1] = {};
+        typedef screen<addr_lower, addr_upper> base;
+        console *_console;
         void project_to_monitor(const REG16 &addr) {
-            console::update_char_on_virtual_monitor(addr-addr_lower, _data[addr-addr_lower]);
+            _console->update_char_on_virtual_monitor(addr-addr_lower, base::_data[addr-addr_lower]);
         }
     public:
-        monitor(system_bus *bus, debugger *debugger)
-            : device(bus, debugger)
+        monitor(system_bus *bus, debugger *debugger, console *console)
+            : base(bus, debugger), _console(console)
         {}
         monitor() = delete;
         monitor(const monitor&) = delete;
@@ -27,22 +29,16 @@ namespace dave
             for(REG16 addr = addr_lower; addr <= addr_upper; addr++) {
                 project_to_monitor(addr);
             }
-            console::reset_cursor();
+            _console->reset_cursor();
         }
-        virtual void nop() override { }
         virtual void write(const REG16 &address, const REG8 *data) override {
+            base::write(address, data);
             if (address >= addr_lower && address <= addr_upper) {
-                _data[address - addr_lower] = *data;
                 project_to_monitor(address);
-                console::reset_cursor();
-            }
-        }
-        virtual void read(const REG16 &address, REG8 *dest) override {  
-            if (address >= addr_lower && address <= addr_upper) {
-                *dest = _data[address - addr_lower];
+                _console->reset_cursor();
             }
         }
     };
 }
 
-#endif
\ No newline at end of file
+#endif
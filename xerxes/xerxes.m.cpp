@@ -3,66 +3,199 @@
 #include "../xerxes_lib/rom.h"
 #include "../xerxes_lib/ram.h"
 #include "../xerxes_lib/punchcardreader.h"
+#include "../xerxes_lib/dma_controller.h"
+#include "../xerxes_lib/interval_timer.h"
+#include "../xerxes_lib/keyboard.h"
+#include "../xerxes_lib/uart.h"
+#include "../xerxes_lib/hdd.h"
 #include "monitor.h"
 #include "emulator_debugger.h"
 #include "console.h"
 #include "../software/romv2.h"
 
-void show_root_commands(const std::string &msg = "")
+#include <iostream>
+#include <string>
+
+void show_root_commands(dave::console &console, const std::string &msg = "")
 {
-    dave::console::show_operation("? (q)uit, (r)un, (s)tep, (l)ine, (w)atch, (b)reak, (p)ause");
+    console.show_operation("? (q)uit, (r)un, (s)tep, (l)ine, (w)atch, (b)reak, (p)ause");
     if (!msg.empty()) {
-        dave::console::alert(msg);
+        console.alert(msg);
     }
 }
 
-int main()
+int main(int argc, char *argv[])
 {
-    dave::console::initialize();
+    std::string rom_image;
+    std::string hdd_image;
+    std::string key_script;
+    std::string serial = "/dev/null";
+    bool typing = false;
+    std::string card = "./software/software.pc";
+    bool dma = false;
+    bool stream = false;
+    uint32_t seed = dave::device_timing::default_seed;
+    size_t fixed_timing = 0;
+    bool skip_idle = true;
+    auto unknown_opcodes = dave::cpu6502::unknown_opcode_policy::nop;
+    for(int i = 1; i < argc; i++) {
+        std::string a(argv[i]);
+        if (a == "--help") {
+            std::cout << "xerxes [options]" << std::endl;
+            std::cout << " -rom: kernel ROM image to load (built-in ROM if not specified)" << std::endl;
+            std::cout << " -pc : punch card to insert in the reader (./software/software.pc if not specified)" << std::endl;
+            std::cout << " -hdd: disk image to attach (no disk if not specified)" << std::endl;
+            std::cout << " -dma: let the punch card reader write data straight to memory" << std::endl;
+            std::cout << " -stream: read the punch card as it is requested, instead of all at startup" << std::endl;
+            std::cout << " -seed: seed for the random device delays" << std::endl;
+            std::cout << " -timing: fixed device delay in ticks, instead of random delays" << std::endl;
+            std::cout << " -no-skip-idle: run every cycle of the cpu's idle loops, instead of skipping to the next device event" << std::endl;
+            std::cout << " -unknown: what the cpu does with opcodes that aren't 65C02 instructions: nop (default), halt or nmos" << std::endl;
+            std::cout << " -keyboard: type on the emulated keyboard while the machine runs (ctrl-b breaks)" << std::endl;
+            std::cout << " -keys: file with the keys to type on the emulated keyboard" << std::endl;
+            std::cout << " -serial: fifo, socket or terminal to connect the UART to, or a file to write its output to" << std::endl;
+            return 0;
+        }
+        else if (a == "-dma") {
+            dma = true;
+        }
+        else if (a == "-stream") {
+            stream = true;
+        }
+        else if (a == "-no-skip-idle") {
+            skip_idle = false;
+        }
+        else if (a == "-seed" && i + 1 < argc) {
+            i++;
+            seed = (uint32_t)strtoul(argv[i], NULL, 10);
+        }
+        else if (a == "-timing" && i + 1 < argc) {
+            i++;
+            fixed_timing = (size_t)strtoul(argv[i], NULL, 10);
+        }
+        else if (a == "-unknown" && i + 1 < argc) {
+            i++;
+            if (!dave::try_parse_unknown_opcode_policy(argv[i], unknown_opcodes)) {
+                std::cerr << "Unknown opcode policy '" << argv[i] << "', use nop, halt or nmos" << std::endl;
+                return 1;
+            }
+        }
+        else if ((a == "-rom" || a == "-pc") && i + 1 < argc) {
+            i++;
+            (a == "-rom" ? rom_image : card) = argv[i];
+        }
+        else if (a == "-hdd" && i + 1 < argc) {
+            i++;
+            hdd_image = argv[i];
+        }
+        else if (a == "-keys" && i + 1 < argc) {
+            i++;
+            key_script = argv[i];
+        }
+        else if (a == "-serial" && i + 1 < argc) {
+            i++;
+            serial = argv[i];
+        }
+        else if (a == "-keyboard") {
+            typing = true;
+        }
+        else {
+            std::cerr << "Unexpected argument '" << a << "'. Use --help for options" << std::endl;
+            return 1;
+        }
+    }
+    if (typing && !key_script.empty()) {
+        std::cerr << "Use either -keyboard or -keys" << std::endl;
+        return 1;
+    }
+
+    // The host side of the devices outlives the machine
+    dave::serial_port serial_port(serial);
+    if (!serial_port.is_open()) {
+        std::cerr << "Failure opening serial line '" << serial << "'" << std::endl;
+        return 1;
+    }
+    dave::key_queue keys;
+    std::unique_ptr<dave::key_feeder> script;
+    if (!key_script.empty()) {
+        script = std::make_unique<dave::key_feeder>(keys, key_script);
+        if (!script->is_open()) {
+            std::cerr << "Failure opening key script '" << key_script << "'" << std::endl;
+            return 1;
+        }
+    }
+
+    dave::console console;
+    console.initialize();
 
-    dave::console::draw_screen();
+    console.draw_screen();
 
-    dave::emulator_debugger debugger;
+    dave::emulator_debugger debugger(console);
 
     dave::machine machine(&debugger);
+    machine.seed(seed);
+    machine.fix_device_timing(fixed_timing);
+    machine.skip_idle(skip_idle);
 
-    machine.install_cpu<dave::cpu6502>();
+    machine.install_cpu<dave::cpu6502>()->_unknown_opcodes = unknown_opcodes;
     
     machine.install_device<dave::ram<0x0000,0x00FF>>(); // Page Zero
     machine.install_device<dave::ram<0x0100,0x01FF>>(); // Stack
     machine.install_device<dave::ram<0x0200, 0x9FFF>>(); // General RAM
     machine.install_device<dave::ram<0xC000, 0xCFFF>>(); // General RAM
     auto kernel_rom = machine.install_device<dave::rom<0xE000, 0xFFFF>>();
-    auto monitor = machine.install_device<dave::monitor<0x0400, 0x07E7>>();
-    auto punchcardreader = machine.install_device<dave::punchcardreader<0xD02F, 0xD030, 0xD031>>("/Users/dlindeque/personal/xerxes/software/software.pc");
+    auto monitor = machine.install_device<dave::monitor<0x0400, 0x07E7>>(&console);
+    auto punchcardreader = machine.install_device<dave::punchcardreader<0xD02F, 0xD030, 0xD031>>(dave::open_card_deck(card, stream), dma);
+    machine.install_device<dave::dma_controller<0xD040>>();
+    machine.install_device<dave::interval_timer<0xD048>>();
+    machine.install_device<dave::keyboard<0xD04E, 0xD04F>>(&keys);
+    machine.install_device<dave::uart<0xD050, 0xD051, 0xD052>>(&serial_port);
+    if (!hdd_image.empty()) {
+        machine.install_device<dave::hdd<0xD032, 0xD033, 0xD034, 0xD036, 0xD037>>(hdd_image);
+    }
 
-    initialize_kernel_rom(kernel_rom);
+    if (rom_image.empty()) {
+        initialize_kernel_rom(kernel_rom);
+    }
+    else if (!kernel_rom->load(rom_image)) {
+        console.teardown();
+        std::cerr << "Failure loading ROM image '" << rom_image << "'" << std::endl;
+        return 1;
+    }
 
     machine.powerup();
     machine.report_cpu_status();
     while(true) {
-        auto key = dave::console::getkey();
-        dave::console::clear_bus();
+        auto key = console.getkey();
+        console.clear_bus();
         switch(key) {
             case 'q':
-                dave::console::teardown();
+                console.teardown();
                 return 0;
             case 'r':
-                dave::console::show_operation("run");
+                console.show_operation("run");
                 debugger._break_after_instruction = false;
-                machine.run();
+                if (typing) {
+                    dave::key_feeder terminal(keys, 0, 0x02);
+                    debugger.typing(&terminal);
+                    machine.run();
+                    debugger.typing(nullptr);
+                }
+                else {
+                    machine.run();
+                }
                 debugger.refresh_watches();
-                show_root_commands();
+                show_root_commands(console);
                 break;
             case 's':
-                dave::console::show_operation("step");
+                console.show_operation("step");
                 debugger._break_after_instruction = true;
                 machine.run();
                 debugger.refresh_watches();
                 break;
             case 'l':
-                dave::console::show_operation("? toggle line (i)rq, (n)mi, (r)eset");
-                key = dave::console::getkey();
+                console.show_operation("? toggle line (i)rq, (n)mi, (r)eset");
+                key = console.getkey();
                 switch(key) {
                     case 'i':
                         machine.toggle_irq();
@@ -74,90 +207,90 @@ int main()
                         machine.toggle_reset();
                         break;
                     default:
-                        show_root_commands("invalid line");
+                        show_root_commands(console, "invalid line");
                         break;
                 }
                 break;
             case 'w':
-                dave::console::show_operation("? (a)dd, (d)elete");
-                key = dave::console::getkey();
+                console.show_operation("? (a)dd, (d)elete");
+                key = console.getkey();
                 switch(key) {
                     case 'a':
                         if (true) {
-                            auto addr = dave::console::get_addr_from_input("Address to watch");
+                            auto addr = console.get_addr_from_input("Address to watch");
                             debugger.add_watch(addr);
                         }
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'd':
                         if (true) {
-                            auto addr = dave::console::get_addr_from_input("Address of watch to delete");
+                            auto addr = console.get_addr_from_input("Address of watch to delete");
                             debugger.delete_watch(addr);
                         }
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     default:
-                        show_root_commands("invalid watch command");
+                        show_root_commands(console, "invalid watch command");
                         break;
                 }
                 break;
             case 'p':
-                dave::console::show_operation("? (p)c value, (b)us, delete p(c), delete b(u)s, on (n)mi, on (i)rq, on (r)eset");
-                key = dave::console::getkey();
+                console.show_operation("? (p)c value, (b)us, delete p(c), delete b(u)s, on (n)mi, on (i)rq, on (r)eset");
+                key = console.getkey();
                 switch(key) {
                     case 'p': // Add a PC address breakpoint
                         if (true) {
-                            auto addr = dave::console::get_addr_from_input("When PC becomes (address)");
+                            auto addr = console.get_addr_from_input("When PC becomes (address)");
                             debugger.add_pc_breakpoint(addr);
                         }
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'b': // Add a bus address breakpoint
                         if (true) {
-                            auto addr = dave::console::get_addr_from_input("Address change to break on (address)");
+                            auto addr = console.get_addr_from_input("Address change to break on (address)");
                             debugger.add_bus_breakpoint(addr);
                         }
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'c': // Delete a PC breakpoint
                         if (true) {
-                            auto addr = dave::console::get_addr_from_input("PC Address to delete");
+                            auto addr = console.get_addr_from_input("PC Address to delete");
                             debugger.delete_pc_breakpoint(addr);
                         }
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'u': // Delete a bus breakpoint
                         if (true) {
-                            auto addr = dave::console::get_addr_from_input("Buss Address to delete");
+                            auto addr = console.get_addr_from_input("Buss Address to delete");
                             debugger.delete_bus_breakpoint(addr);
                         }
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'n':
                         debugger.toggle_break_on_nmi();
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'i':
                         debugger.toggle_break_on_irq();
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     case 'r':
                         debugger.toggle_break_on_reset();
-                        show_root_commands();
+                        show_root_commands(console);
                         break;
                     default:
-                        show_root_commands("invalid pause command");
+                        show_root_commands(console, "invalid pause command");
                         break;
                 }
                 break;
             default:
-                show_root_commands("Invalid command");
+                show_root_commands(console, "Invalid command");
                 break;
         }
         machine.report_cpu_status();
     }
     
-    dave::console::teardown();
+    console.teardown();
 
     return 0;
 }
@@ -0,0 +1,118 @@
+#include "batch_debugger.h"
+
+namespace dave
+{
+
+void batch_debugger::attach_system_bus(system_bus *bus)
+{}
+
+bool batch_debugger::break_on_started()
+{
+    return false;
+}
+
+bool batch_debugger::break_on_next_instruction_ready(const REG16 &next_instruction_addr)
+{
+    if (_halt_on_pc && next_instruction_addr == _halt_pc) {
+        _halt = halt_reason::halt_pc;
+        return true;
+    }
+    return false;
+}
+
+bool batch_debugger::break_after_instruction()
+{
+    return false;
+}
+
+bool batch_debugger::break_on_reset()
+{
+    return false;
+}
+
+bool batch_debugger::break_on_nmi()
+{
+    return false;
+}
+
+bool batch_debugger::break_on_interupt()
+{
+    return false;
+}
+
+bool batch_debugger::break_on_break()
+{
+    if (_halt_on_break) {
+        _halt = halt_reason::brk;
+    }
+    return _halt_on_break;
+}
+
+bool batch_debugger::break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode)
+{
+    _halt = halt_reason::unknown_opcode;
+    return true;
+}
+
+bool batch_debugger::break_on_stop(const REG16 &addr)
+{
+    _halt = halt_reason::stp;
+    return true;
+}
+
+bool batch_debugger::break_asap()
+{
+    if (_max_ticks != 0 && _ticks >= _max_ticks) {
+        _halt = halt_reason::max_ticks;
+        return true;
+    }
+    return false;
+}
+
+bool batch_debugger::break_on_bus_address_changed(const REG16 &addr)
+{
+    return false;
+}
+
+void batch_debugger::report_cpu_register(const std::string &name, const uint8_t &value)
+{}
+
+void batch_debugger::report_cpu_register(const std::string &name, const uint16_t &value)
+{}
+
+void batch_debugger::report_cpu_register(const std::string &name, const bool &value)
+{}
+
+void batch_debugger::tick()
+{
+    _ticks++;
+}
+
+void batch_debugger::tick(size_t count)
+{
+    _ticks += count;
+}
+
+size_t batch_debugger::idle_cycles_allowed()
+{
+    // Stop short of the limit, the machine halts on it as if every cycle ran
+    if (_max_ticks == 0) return SIZE_MAX;
+    return _ticks + 1 < _max_ticks ? _max_ticks - _ticks - 1 : 0;
+}
+
+void batch_debugger::report_address_write(const REG16 &addr, const REG8 *data)
+{}
+
+void batch_debugger::report_nmi_line(bool value)
+{}
+
+void batch_debugger::report_irq_line(bool value)
+{}
+
+void batch_debugger::report_reset_line(bool value)
+{}
+
+void batch_debugger::report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer)
+{}
+
+}
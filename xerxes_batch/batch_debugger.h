@@ -0,0 +1,63 @@
+#ifndef __BATCH_DEBUGGERH
+#define __BATCH_DEBUGGERH
+
+#include <atomic>
+#include "../xerxes_lib/debugger.h"
+
+namespace dave
+{
+    // Debugger for headless runs. It never reports anything, and stops the machine on a halt condition. Safe to use
+    // from the cpu threads of a parallel machine.
+    class batch_debugger : public debugger {
+    public:
+        enum class halt_reason {
+            none,
+            halt_pc,
+            brk,
+            unknown_opcode,
+            stp,
+            max_ticks
+        };
+    private:
+        size_t _ticks = 0;
+        std::atomic<halt_reason> _halt { halt_reason::none };
+    public:
+        size_t _max_ticks = 0; // 0 = no limit
+        bool _halt_on_pc = false;
+        REG16 _halt_pc = 0;
+        bool _halt_on_break = true;
+
+        auto ticks() const -> size_t { return _ticks; }
+        auto halt() const -> halt_reason { return _halt; }
+
+        virtual void attach_system_bus(system_bus *bus) override;
+
+        virtual bool break_on_started() override;
+        virtual bool break_on_next_instruction_ready(const REG16 &next_instruction_addr) override;
+        virtual bool break_after_instruction() override;
+        virtual bool break_on_reset() override;
+        virtual bool break_on_nmi() override;
+        virtual bool break_on_interupt() override;
+        virtual bool break_on_break() override;
+        virtual bool break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode) override;
+        virtual bool break_on_stop(const REG16 &addr) override;
+        virtual bool break_asap() override;
+        virtual bool break_on_bus_address_changed(const REG16 &addr) override;
+
+        virtual void report_cpu_register(const std::string &name, const uint8_t &value) override;
+        virtual void report_cpu_register(const std::string &name, const uint16_t &value) override;
+        virtual void report_cpu_register(const std::string &name, const bool &value) override;
+        virtual void tick() override;
+        virtual void tick(size_t count) override;
+        virtual size_t idle_cycles_allowed() override;
+        virtual void report_address_write(const REG16 &addr, const REG8 *data) override;
+
+        virtual void report_nmi_line(bool value) override;
+        virtual void report_irq_line(bool value) override;
+        virtual void report_reset_line(bool value) override;
+
+        virtual void report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer) override;
+    };
+}
+
+#endif
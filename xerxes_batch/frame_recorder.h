@@ -0,0 +1,64 @@
+#ifndef __FRAME_RECORDERH
+#define __FRAME_RECORDERH
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../xerxes_lib/device.h"
+#include "../xerxes_lib/system_bus.h"
+
+namespace dave
+{
+    // Writes the screen to text files named <prefix>.<cycle>.txt: at the given cycles, or, without any, whenever the
+    // screen changed (looked at every check_cycles). It waits on the bus's event schedule, and is not on the bus.
+    template<typename TScreen> class frame_recorder : public device {
+    private:
+        TScreen *_screen;
+        std::string _prefix;
+        std::vector<size_t> _at;
+        size_t _check_cycles;
+    public:
+        frame_recorder(system_bus *bus, debugger *debugger, TScreen *screen, const std::string &prefix, const std::vector<size_t> &at, size_t check_cycles = 20000)
+            : device(bus, debugger), _screen(screen), _prefix(prefix), _at(at), _check_cycles(check_cycles)
+        {}
+        frame_recorder() = delete;
+        frame_recorder(const frame_recorder&) = delete;
+        frame_recorder(frame_recorder &&) = delete;
+        auto operator =(const frame_recorder&)->frame_recorder& = delete;
+        auto operator =(frame_recorder &&)->frame_recorder& = delete;
+
+        void dump(const std::string &name) {
+            std::ofstream stm(_prefix + "." + name + ".txt");
+            stm << _screen->text();
+        }
+
+        virtual void powerup() override {
+            if (_at.empty()) {
+                _bus->schedule(this, _check_cycles);
+            }
+            for(auto cycle : _at) {
+                if (cycle > _bus->now()) {
+                    _bus->schedule(this, cycle - _bus->now());
+                }
+            }
+        }
+        virtual void event(size_t tag) override {
+            if (!_at.empty()) {
+                dump(std::to_string(_bus->now()));
+                return;
+            }
+            if (_screen->dirty_rows() != 0) {
+                _screen->clean();
+                dump(std::to_string(_bus->now()));
+            }
+            _bus->schedule(this, _check_cycles);
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override { }
+        virtual void read(const REG16 &address, REG8 *dest) override { }
+        virtual bool decodes(REG8 page) override { return false; }
+    };
+}
+
+#endif
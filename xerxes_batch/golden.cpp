@@ -0,0 +1,110 @@
+#include "golden.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace dave
+{
+
+uint64_t page_hash(const REG8 *page)
+{
+    // FNV-1a
+    uint64_t h = 14695981039346656037ull;
+    for(size_t i = 0; i < 256; i++) {
+        h ^= page[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+bool try_write_golden(const std::string &fn, const run_outcome &outcome)
+{
+    std::ofstream stm(fn);
+    if (!stm) {
+        return false;
+    }
+    stm << "halt " << outcome.halt << std::endl;
+    stm << "ticks " << outcome.ticks << std::endl;
+    stm << "registers " << outcome.registers << std::endl;
+    stm << std::hex << std::setfill('0');
+    for(auto &p : outcome.pages) {
+        stm << "page " << std::setw(2) << (unsigned int)p.first << " " << std::setw(16) << p.second << std::endl;
+    }
+    stm << "screen" << std::endl;
+    stm << outcome.screen;
+    return (bool)stm;
+}
+
+bool try_read_golden(const std::string &fn, run_outcome &outcome)
+{
+    std::ifstream stm(fn);
+    if (!stm) {
+        return false;
+    }
+    std::string line;
+    while(std::getline(stm, line)) {
+        std::istringstream words(line);
+        std::string key;
+        words >> key;
+        if (key == "halt") {
+            words >> outcome.halt;
+        }
+        else if (key == "ticks") {
+            words >> outcome.ticks;
+        }
+        else if (key == "registers") {
+            std::getline(words >> std::ws, outcome.registers);
+        }
+        else if (key == "page") {
+            unsigned int page;
+            uint64_t hash;
+            words >> std::hex >> page >> hash;
+            if (!words || page > 0xFF) {
+                return false;
+            }
+            outcome.pages[(REG8)page] = hash;
+        }
+        else if (key == "screen") {
+            // The rest of the file
+            std::ostringstream rest;
+            rest << stm.rdbuf();
+            outcome.screen = rest.str();
+            break;
+        }
+        else if (!key.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> compare_outcome(const run_outcome &golden, const run_outcome &actual, const tick_tolerance &tolerance)
+{
+    std::vector<std::string> differences;
+    if (golden.halt != actual.halt) {
+        differences.push_back("halt " + actual.halt + ", expected " + golden.halt);
+    }
+    auto allowed = tolerance.percent ? golden.ticks * tolerance.value / 100 : tolerance.value;
+    auto off = golden.ticks > actual.ticks ? golden.ticks - actual.ticks : actual.ticks - golden.ticks;
+    if (off > allowed) {
+        differences.push_back("ticks " + std::to_string(actual.ticks) + ", expected " + std::to_string(golden.ticks));
+    }
+    if (golden.registers != actual.registers) {
+        differences.push_back("registers " + actual.registers + ", expected " + golden.registers);
+    }
+    for(auto &p : golden.pages) {
+        auto a = actual.pages.find(p.first);
+        if (a == actual.pages.end() || a->second != p.second) {
+            std::ostringstream stm;
+            stm << "page " << std::hex << std::setfill('0') << std::setw(2) << (unsigned int)p.first << " differs";
+            differences.push_back(stm.str());
+        }
+    }
+    if (golden.screen != actual.screen) {
+        differences.push_back("screen differs");
+    }
+    return differences;
+}
+
+}
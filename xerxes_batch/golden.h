@@ -0,0 +1,43 @@
+#ifndef __GOLDENH
+#define __GOLDENH
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../xerxes_lib/common.h"
+
+namespace dave
+{
+    // What a run is checked on: how it halted, after how many ticks, the registers, the RAM (a hash per page) and the screen
+    struct run_outcome {
+        std::string halt;
+        size_t ticks = 0;
+        std::string registers;
+        std::map<REG8, uint64_t> pages;
+        std::string screen;
+    };
+
+    // How far the ticks may be off: a number of ticks, or a percentage of the golden ticks
+    struct tick_tolerance {
+        size_t value = 0;
+        bool percent = false;
+    };
+
+    auto page_hash(const REG8 *page) -> uint64_t;
+
+    // The golden file is text, so a change shows up in a diff:
+    //   halt max
+    //   ticks 400001
+    //   registers PC=022d A=48 X=00 Y=00 S=ff P=02
+    //   page 02 7e2a0c5d3b4f0e11
+    //   screen
+    //   <the lines of the screen>
+    bool try_write_golden(const std::string &fn, const run_outcome &outcome);
+    bool try_read_golden(const std::string &fn, run_outcome &outcome);
+
+    // The differences, none if the run matches. Only the pages in the golden file are compared.
+    auto compare_outcome(const run_outcome &golden, const run_outcome &actual, const tick_tolerance &tolerance) -> std::vector<std::string>;
+}
+
+#endif
@@ -0,0 +1,426 @@
+#include "../xerxes_lib/machine.h"
+#include "../xerxes_lib/cpu6502.h"
+#include "../xerxes_lib/rom.h"
+#include "../xerxes_lib/ram.h"
+#include "../xerxes_lib/punchcardreader.h"
+#include "../xerxes_lib/dma_controller.h"
+#include "../xerxes_lib/interval_timer.h"
+#include "../xerxes_lib/keyboard.h"
+#include "../xerxes_lib/uart.h"
+#include "../xerxes_lib/screen.h"
+#include "../xerxes_lib/work_pool.h"
+#include "batch_debugger.h"
+#include "frame_recorder.h"
+#include "golden.h"
+#include "../software/romv2.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct job {
+    std::string deck;
+    std::string rom; // The built-in ROM if empty
+    size_t max_ticks = 0;
+    bool halt_on_pc = false;
+    dave::REG16 halt_pc = 0;
+    uint32_t seed = dave::device_timing::default_seed;
+    bool dma = false;
+    size_t quantum = 1;
+    bool skip_idle = true;
+    bool parallel = false;
+    dave::cpu6502::unknown_opcode_policy unknown_opcodes = dave::cpu6502::unknown_opcode_policy::halt;
+    std::string keys; // key script, no keys if empty
+    std::string serial = "/dev/null";
+    std::string frames;            // directory to write the frames to, none if empty
+    std::vector<size_t> frames_at; // cycles to write a frame at, whenever the screen changed if empty
+    std::string profile;           // directory to write the bus profile to, none if empty
+    std::string golden;            // directory with the golden files to check against, no check if empty
+    bool record = false;           // write the golden files, instead of checking against them
+    dave::tick_tolerance tolerance;
+    std::set<dave::REG8> pages;    // the RAM pages to check, all of them if empty
+};
+
+typedef dave::screen<0x0400, 0x07E7> batch_screen;
+
+struct result {
+    std::string error;
+    dave::batch_debugger::halt_reason halt = dave::batch_debugger::halt_reason::none;
+    size_t ticks = 0;
+    dave::cpu6502::registers registers = {};
+    dave::run_outcome outcome;
+};
+
+const char* halt_name(dave::batch_debugger::halt_reason halt)
+{
+    switch(halt) {
+        case dave::batch_debugger::halt_reason::halt_pc: return "pc";
+        case dave::batch_debugger::halt_reason::brk: return "brk";
+        case dave::batch_debugger::halt_reason::unknown_opcode: return "opcode";
+        case dave::batch_debugger::halt_reason::stp: return "stp";
+        case dave::batch_debugger::halt_reason::max_ticks: return "max";
+        default: return "none";
+    }
+}
+
+std::string format_registers(const dave::cpu6502::registers &registers)
+{
+    std::ostringstream stm;
+    stm << std::hex << std::setfill('0');
+    stm << "PC=" << std::setw(4) << (unsigned int)registers.PC;
+    stm << " A=" << std::setw(2) << (unsigned int)registers.A;
+    stm << " X=" << std::setw(2) << (unsigned int)registers.X;
+    stm << " Y=" << std::setw(2) << (unsigned int)registers.Y;
+    stm << " S=" << std::setw(2) << (unsigned int)registers.S;
+    stm << " P=" << std::setw(2) << (unsigned int)*((dave::REG8*)&registers.P);
+    return stm.str();
+}
+
+void run_job(const job &j, result &r)
+{
+    dave::serial_port serial(j.serial);
+    if (!serial.is_open()) {
+        r.error = "failure opening serial line '" + j.serial + "'";
+        return;
+    }
+    dave::key_queue keys;
+    std::unique_ptr<dave::key_feeder> script;
+    if (!j.keys.empty()) {
+        script = std::make_unique<dave::key_feeder>(keys, j.keys);
+        if (!script->is_open()) {
+            r.error = "failure opening key script '" + j.keys + "'";
+            return;
+        }
+    }
+
+    dave::batch_debugger debugger;
+    debugger._max_ticks = j.max_ticks;
+    debugger._halt_on_pc = j.halt_on_pc;
+    debugger._halt_pc = j.halt_pc;
+
+    dave::machine machine(&debugger);
+    machine.realtime(false);
+    machine.seed(j.seed);
+    machine.quantum(j.quantum);
+    machine.skip_idle(j.skip_idle);
+
+    auto cpu = machine.install_cpu<dave::cpu6502>();
+    cpu->_unknown_opcodes = j.unknown_opcodes;
+    machine.parallel(j.parallel);
+    std::vector<dave::device*> memory;
+    memory.push_back(machine.install_device<dave::ram<0x0000,0x00FF>>()); // Page Zero
+    memory.push_back(machine.install_device<dave::ram<0x0100,0x01FF>>()); // Stack
+    memory.push_back(machine.install_device<dave::ram<0x0200, 0x9FFF>>()); // General RAM (includes the screen buffer)
+    memory.push_back(machine.install_device<dave::ram<0xC000, 0xCFFF>>()); // General RAM
+    auto kernel_rom = machine.install_device<dave::rom<0xE000, 0xFFFF>>();
+    machine.install_device<dave::punchcardreader<0xD02F, 0xD030, 0xD031>>(j.deck, j.dma);
+    machine.install_device<dave::dma_controller<0xD040>>();
+    machine.install_device<dave::interval_timer<0xD048>>();
+    machine.install_device<dave::keyboard<0xD04E, 0xD04F>>(&keys);
+    machine.install_device<dave::uart<0xD050, 0xD051, 0xD052>>(&serial);
+    auto screen = machine.install_device<batch_screen>();
+    auto name = j.deck.substr(j.deck.find_last_of('/') + 1);
+    dave::frame_recorder<batch_screen> *recorder = nullptr;
+    if (!j.frames.empty()) {
+        recorder = machine.install_device<dave::frame_recorder<batch_screen>>(screen, j.frames + "/" + name, j.frames_at);
+    }
+
+    if (j.rom.empty()) {
+        initialize_kernel_rom(kernel_rom);
+    }
+    else if (!kernel_rom->load(j.rom)) {
+        r.error = "failure loading ROM image '" + j.rom + "'";
+        return;
+    }
+
+    machine.profile(!j.profile.empty());
+    machine.powerup();
+    if (recorder != nullptr) {
+        recorder->dump("final");
+    }
+    if (!j.profile.empty()) {
+        auto fn = j.profile + "/" + name + ".profile.txt";
+        std::ofstream stm(fn);
+        // The devices' registers are all in page D0
+        machine.report_profile(stm, { 0xD0 });
+        if (!stm) {
+            r.error = "failure writing the profile '" + fn + "'";
+            return;
+        }
+    }
+
+    r.halt = debugger.halt();
+    r.ticks = debugger.ticks();
+    r.registers = cpu->_registers;
+
+    r.outcome.halt = halt_name(r.halt);
+    r.outcome.ticks = r.ticks;
+    r.outcome.registers = format_registers(r.registers);
+    for(size_t page = 0; page < 256; page++) {
+        if (!j.pages.empty() && j.pages.find((dave::REG8)page) == j.pages.end()) continue;
+        for(auto m : memory) {
+            auto data = m->direct((dave::REG8)page);
+            if (data != nullptr) {
+                r.outcome.pages[(dave::REG8)page] = dave::page_hash(data);
+                break;
+            }
+        }
+    }
+    r.outcome.screen = screen->text();
+}
+
+// Check the run against its golden file, or record it
+bool check_golden(const job &j, const result &r)
+{
+    auto fn = j.golden + "/" + j.deck.substr(j.deck.find_last_of('/') + 1) + ".golden";
+    if (j.record) {
+        if (!dave::try_write_golden(fn, r.outcome)) {
+            std::cout << "  failure writing '" << fn << "'" << std::endl;
+            return false;
+        }
+        std::cout << "  recorded " << fn << std::endl;
+        return true;
+    }
+    dave::run_outcome golden;
+    if (!dave::try_read_golden(fn, golden)) {
+        std::cout << "  failure reading '" << fn << "'" << std::endl;
+        return false;
+    }
+    if (!j.pages.empty()) {
+        for(auto p = golden.pages.begin(); p != golden.pages.end();) {
+            p = j.pages.find(p->first) == j.pages.end() ? golden.pages.erase(p) : std::next(p);
+        }
+    }
+    auto differences = dave::compare_outcome(golden, r.outcome, j.tolerance);
+    for(auto &d : differences) {
+        std::cout << "  FAIL " << d << std::endl;
+    }
+    if (differences.empty()) {
+        std::cout << "  matches " << fn << std::endl;
+    }
+    return differences.empty();
+}
+
+// Parse the options of a job, i.e. "-rom romv2.rom -max 1000000 software.pc". The options apply to
+// all the decks, wherever they are specified.
+bool try_parse_job(const std::vector<std::string> &args, size_t &i, job &j, std::vector<std::string> &decks)
+{
+    auto &a = args[i];
+    bool has_value = i + 1 < args.size();
+    if (a == "-rom" && has_value) {
+        j.rom = args[++i];
+    }
+    else if (a == "-max" && has_value) {
+        j.max_ticks = (size_t)strtoull(args[++i].c_str(), NULL, 10);
+    }
+    else if (a == "-halt" && has_value) {
+        j.halt_on_pc = true;
+        j.halt_pc = (dave::REG16)strtol(args[++i].c_str(), NULL, 16);
+    }
+    else if (a == "-seed" && has_value) {
+        j.seed = (uint32_t)strtoul(args[++i].c_str(), NULL, 10);
+    }
+    else if (a == "-frames" && has_value) {
+        j.frames = args[++i];
+    }
+    else if (a == "-profile" && has_value) {
+        j.profile = args[++i];
+    }
+    else if (a == "-frame-at" && has_value) {
+        // i.e. 100000,250000
+        std::istringstream cycles(args[++i]);
+        std::string c;
+        while(std::getline(cycles, c, ',')) {
+            j.frames_at.push_back((size_t)strtoull(c.c_str(), NULL, 10));
+        }
+    }
+    else if ((a == "-golden" || a == "-record") && has_value) {
+        j.golden = args[++i];
+        j.record = a == "-record";
+    }
+    else if (a == "-tolerance" && has_value) {
+        // Ticks, or a percentage: 1000 or 5%
+        auto &t = args[++i];
+        j.tolerance.value = (size_t)strtoull(t.c_str(), NULL, 10);
+        j.tolerance.percent = !t.empty() && t.back() == '%';
+    }
+    else if (a == "-pages" && has_value) {
+        // Address ranges, i.e. 0000-01FF,0400-07FF
+        std::istringstream ranges(args[++i]);
+        std::string range;
+        while(std::getline(ranges, range, ',')) {
+            auto lo = strtoul(range.c_str(), NULL, 16);
+            auto dash = range.find('-');
+            auto hi = dash == std::string::npos ? lo : strtoul(range.c_str() + dash + 1, NULL, 16);
+            for(auto page = lo >> 8; page <= (hi >> 8) && page <= 0xFF; page++) {
+                j.pages.insert((dave::REG8)page);
+            }
+        }
+    }
+    else if (a == "-serial" && has_value) {
+        j.serial = args[++i];
+    }
+    else if (a == "-keys" && has_value) {
+        j.keys = args[++i];
+    }
+    else if (a == "-quantum" && has_value) {
+        j.quantum = (size_t)strtoul(args[++i].c_str(), NULL, 10);
+    }
+    else if (a == "-dma") {
+        j.dma = true;
+    }
+    else if (a == "-no-skip-idle") {
+        j.skip_idle = false;
+    }
+    else if (a == "-parallel") {
+        j.parallel = true;
+    }
+    else if (a == "-unknown" && has_value) {
+        if (!dave::try_parse_unknown_opcode_policy(args[++i], j.unknown_opcodes)) {
+            std::cerr << "Unknown opcode policy '" << args[i] << "', use nop, halt or nmos" << std::endl;
+            return false;
+        }
+    }
+    else if (!a.empty() && a[0] != '-') {
+        decks.push_back(a);
+    }
+    else {
+        std::cerr << "Unexpected argument '" << a << "'. Use --help for options" << std::endl;
+        return false;
+    }
+    i++;
+    return true;
+}
+
+// Every line of a job file is a job, with the same options as the command line. The options on the
+// command line are the defaults. Lines starting with ';' are comments.
+bool try_read_job_file(const std::string &fn, const job &defaults, std::vector<job> &jobs)
+{
+    std::ifstream stm(fn);
+    if (!stm) {
+        std::cerr << "Failure opening job file '" << fn << "'" << std::endl;
+        return false;
+    }
+    std::string line;
+    while(std::getline(stm, line)) {
+        std::vector<std::string> args;
+        std::istringstream words(line.substr(0, line.find(';')));
+        std::string w;
+        while(words >> w) {
+            args.push_back(w);
+        }
+        job j = defaults;
+        std::vector<std::string> decks;
+        size_t i = 0;
+        while(i < args.size()) {
+            if (!try_parse_job(args, i, j, decks)) {
+                return false;
+            }
+        }
+        for(auto &d : decks) {
+            jobs.push_back(j);
+            jobs.back().deck = d;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 2 && std::string(argv[1]) == "--help") {
+        std::cout << "xerxes_batch [options] [decks]" << std::endl;
+        std::cout << " -threads: number of host threads (one per core if not specified)" << std::endl;
+        std::cout << " -jobs   : file with a job per line, using the options below" << std::endl;
+        std::cout << " -rom    : kernel ROM image to load (built-in ROM if not specified)" << std::endl;
+        std::cout << " -max    : halt after this many ticks" << std::endl;
+        std::cout << " -halt   : halt when the PC reaches this address (hex)" << std::endl;
+        std::cout << " -seed   : seed for the random device delays" << std::endl;
+        std::cout << " -dma    : let the punch card reader write data straight to memory" << std::endl;
+        std::cout << " -quantum: cycles the cpu runs before it yields the bus (1 = lockstep)" << std::endl;
+        std::cout << " -no-skip-idle: run every cycle of the cpu's idle loops, instead of skipping to the next device event" << std::endl;
+        std::cout << " -parallel: run the cpu on its own host thread, a round (at least 256 cycles) at a time, the way multi-cpu machines run in parallel" << std::endl;
+        std::cout << " -unknown: what the cpu does with opcodes that aren't 65C02 instructions: halt (default), nop or nmos" << std::endl;
+        std::cout << " -keys   : file with the keys to type on the keyboard" << std::endl;
+        std::cout << " -serial : where the UART connects to ('-' for stdin/stdout, a fifo or socket, or a file for its output)" << std::endl;
+        std::cout << " -frames : directory to write the screen to (<deck>.<cycle>.txt) whenever it changed, and at the end" << std::endl;
+        std::cout << " -frame-at: cycles to write the screen at (i.e. 100000,250000), instead of on every change" << std::endl;
+        std::cout << " -profile: directory to write the bus accesses per address to (<deck>.profile.txt), runs every idle cycle" << std::endl;
+        std::cout << " -golden : directory with the golden files (<deck>.golden) to check the runs against" << std::endl;
+        std::cout << " -record : directory to write the golden files to" << std::endl;
+        std::cout << " -tolerance: how many ticks (or 5%) the runs may be off from the golden files" << std::endl;
+        std::cout << " -pages  : the RAM to check, i.e. 0000-01FF,0400-07FF (all of it if not specified)" << std::endl;
+        std::cout << "Every deck is run on its own machine, until BRK, STP, an unknown opcode (with -unknown halt) or one of the halt conditions" << std::endl;
+        return 0;
+    }
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    size_t threads = 0;
+    job defaults;
+    std::vector<std::string> decks;
+    std::vector<std::string> job_files;
+    size_t i = 0;
+    while(i < args.size()) {
+        if (args[i] == "-threads" && i + 1 < args.size()) {
+            threads = (size_t)strtoul(args[i + 1].c_str(), NULL, 10);
+            i += 2;
+        }
+        else if (args[i] == "-jobs" && i + 1 < args.size()) {
+            job_files.push_back(args[i + 1]);
+            i += 2;
+        }
+        else if (!try_parse_job(args, i, defaults, decks)) {
+            return 1;
+        }
+    }
+    std::vector<job> jobs;
+    for(auto &d : decks) {
+        jobs.push_back(defaults);
+        jobs.back().deck = d;
+    }
+    for(auto &fn : job_files) {
+        if (!try_read_job_file(fn, defaults, jobs)) {
+            return 1;
+        }
+    }
+    if (jobs.empty()) {
+        std::cerr << "No decks to run" << std::endl;
+        return 1;
+    }
+
+    std::vector<result> results(jobs.size());
+    std::vector<std::function<void()> > tasks;
+    for(size_t n = 0; n < jobs.size(); n++) {
+        tasks.push_back([&jobs, &results, n]() { run_job(jobs[n], results[n]); });
+    }
+
+    dave::work_pool pool(threads);
+    auto started = std::chrono::steady_clock::now();
+    pool.run(std::move(tasks));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+
+    // Report in job order, regardless of the order they completed in
+    int rc = 0;
+    for(size_t n = 0; n < jobs.size(); n++) {
+        auto &r = results[n];
+        std::cout << jobs[n].deck << ": ";
+        if (!r.error.empty()) {
+            std::cout << "error " << r.error << std::endl;
+            rc = 1;
+            continue;
+        }
+        std::cout << "halt=" << halt_name(r.halt) << " ticks=" << r.ticks << " " << format_registers(r.registers) << std::endl;
+        if (!jobs[n].golden.empty() && !check_golden(jobs[n], r)) {
+            rc = 1;
+        }
+    }
+    std::cout << jobs.size() << " jobs on " << pool.threads() << " threads in " << elapsed.count() << " ms" << std::endl;
+
+    return rc;
+}
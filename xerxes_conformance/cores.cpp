@@ -0,0 +1,44 @@
+#include "cores.h"
+
+namespace dave
+{
+    namespace
+    {
+        const std::vector<core> cores = {
+            { "cpu6502", [](system_bus *bus, debugger *debugger) { return std::make_unique<cpu6502>(bus, debugger); } },
+        };
+    }
+
+    auto cpu_cores() -> const std::vector<core>&
+    {
+        return cores;
+    }
+
+    auto find_core(const std::string &name) -> const core*
+    {
+        for(auto &c : cores) {
+            if (c.name == name) return &c;
+        }
+        return nullptr;
+    }
+
+    auto step_instruction(cpu6502 *cpu, step_debugger &debugger, bool use_run) -> size_t
+    {
+        const size_t limit = 100;
+        debugger.start();
+        if (use_run) {
+            size_t cycles = limit + 1;
+            if (!cpu->run(cycles)) return 0;
+            // run() counts the tick that broke at the next instruction
+            return limit - cycles;
+        }
+        size_t cycles = 0;
+        while(!cpu->tick()) {
+            ++cycles;
+            // After WAI or STP the cpu sleeps instead of getting to the next instruction
+            if (cpu->asleep() && cpu->_cycles_left_for_current_operation == 0) return cycles;
+            if (cycles > limit) return 0;
+        }
+        return cycles;
+    }
+}
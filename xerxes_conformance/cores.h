@@ -0,0 +1,29 @@
+#ifndef __CORESH
+#define __CORESH
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../xerxes_lib/cpu6502.h"
+#include "step_debugger.h"
+
+namespace dave
+{
+    // A cpu core to check. A faster core only has to be added to cpu_cores() to be checked against the vectors, and
+    // fuzzed against the other cores.
+    struct core {
+        std::string name;
+        std::function<std::unique_ptr<cpu6502>(system_bus*, debugger*)> create;
+    };
+
+    auto cpu_cores() -> const std::vector<core>&;
+    auto find_core(const std::string &name) -> const core*;
+
+    // Run the cpu for one instruction, cycle by cycle through tick(), or in one go through run() (the way the bus
+    // runs it). Returns the cycles the instruction took, 0 if it didn't complete within 100 cycles.
+    auto step_instruction(cpu6502 *cpu, step_debugger &debugger, bool use_run) -> size_t;
+}
+
+#endif
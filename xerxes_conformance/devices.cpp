@@ -0,0 +1,346 @@
+#include "devices.h"
+
+#include <sstream>
+#include <vector>
+
+#include "../xerxes_lib/system_bus.h"
+#include "../xerxes_lib/banked_ram.h"
+#include "../xerxes_lib/cpu6502.h"
+#include "../xerxes_lib/dma_controller.h"
+#include "../xerxes_lib/interval_timer.h"
+#include "../xerxes_lib/ram.h"
+#include "../xerxes_lib/screen.h"
+#include "step_debugger.h"
+
+namespace dave
+{
+    namespace
+    {
+        // Lets a cpu run freely
+        class free_debugger : public step_debugger {
+        public:
+            virtual bool break_on_next_instruction_ready(const REG16 &next_instruction_addr) override { return false; }
+            virtual bool break_on_stop(const REG16 &addr) override { return false; }
+        };
+
+        // A bus without a cpu, the checks read and write it themselves
+        struct bench {
+            bool irq = false;
+            bool nmi = false;
+            free_debugger debugger;
+            system_bus bus;
+
+            bench()
+            : bus(&debugger, irq, nmi)
+            {}
+
+            void poke(REG16 address, REG8 value) { bus.write(address, &value); }
+            auto peek(REG16 address) -> REG8 {
+                REG8 value = 0;
+                bus.read(address, &value);
+                return value;
+            }
+        };
+
+        auto describe(const std::string &what, REG16 address, REG8 value, REG8 expected) -> std::string
+        {
+            std::ostringstream stm;
+            stm << std::hex << what << " " << address << "=" << (unsigned int)value << " (" << (unsigned int)expected << ")";
+            return stm.str();
+        }
+
+        // The byte at the address, through the bus and through the page's direct() pointer. Empty if both are right.
+        auto expect(bench &b, REG16 address, REG8 expected) -> std::string
+        {
+            auto value = b.peek(address);
+            if (value != expected) return describe("read", address, value, expected);
+            auto page = b.bus.direct((REG8)(address >> 8));
+            if (page == nullptr) return describe("no direct page for", address, 0, expected);
+            if (page[address & 0xFF] != expected) return describe("direct", address, page[address & 0xFF], expected);
+            return "";
+        }
+
+        const REG16 dma = 0xD040;
+        const size_t dma_setup_cycles = 4;
+
+        // Starts a transfer, and ticks the bus up to the cycle it is due. Until then nothing may change, from then on
+        // the transfer is done and the IRQ up, until the status is read. The bus writes the transfer made are left in
+        // the debugger.
+        auto transfer(bench &b, dma_controller<dma>::mode mode, REG16 source, REG16 destination, REG16 length) -> std::string
+        {
+            std::vector<REG8> before(0x10000);
+            for(size_t a = 0; a < before.size(); a++) {
+                before[a] = b.peek((REG16)a);
+            }
+            b.poke(dma + 0, (REG8)source);
+            b.poke(dma + 1, (REG8)(source >> 8));
+            b.poke(dma + 2, (REG8)destination);
+            b.poke(dma + 3, (REG8)(destination >> 8));
+            b.poke(dma + 4, (REG8)length);
+            b.poke(dma + 5, (REG8)(length >> 8));
+            b.poke(dma + 6, (REG8)mode);
+            b.poke(dma + 7, 0x01);
+            b.debugger.start();
+
+            auto due = b.bus.now() + dma_setup_cycles + length;
+            while(b.bus.now() + 1 < due) {
+                b.bus.tick();
+                if (b.bus.irq()) return "the IRQ came at cycle " + std::to_string(b.bus.now()) + " (" + std::to_string(due) + ")";
+            }
+            for(size_t a = 0; a < before.size(); a++) {
+                if (a < dma || a > dma + 7) {
+                    auto value = b.peek((REG16)a);
+                    if (value != before[a]) return describe("the cycle before it was due", (REG16)a, value, before[a]);
+                }
+            }
+            if (b.peek(dma + 7) != (REG8)dma_controller<dma>::status::busy) return "not busy the cycle before it was due";
+            b.bus.tick();
+            if (!b.bus.irq()) return "no IRQ at cycle " + std::to_string(b.bus.now());
+            if (b.peek(dma + 7) != (REG8)dma_controller<dma>::status::done) return "not done once it was due";
+            if (b.bus.irq()) return "reading the status didn't clear the IRQ";
+            return "";
+        }
+
+        const REG16 timer = 0xD048;
+        typedef interval_timer<timer> timer_device;
+
+        auto tick_to(bench &b, size_t cycle) {
+            while(b.bus.now() < cycle) {
+                b.bus.tick();
+            }
+        }
+
+        auto count(bench &b) -> size_t {
+            return b.peek(timer + 4) | ((size_t)b.peek(timer + 5) << 8);
+        }
+
+        // What the timer shows at a cycle, empty if it is right
+        auto expect_timer(bench &b, size_t cycle, size_t remaining, bool irq, bool nmi) -> std::string
+        {
+            tick_to(b, cycle);
+            auto at = "cycle " + std::to_string(cycle) + ": ";
+            if (count(b) != remaining) return at + "count " + std::to_string(count(b)) + " (" + std::to_string(remaining) + ")";
+            if (b.bus.irq() != irq) return at + "IRQ " + std::to_string(b.bus.irq()) + " (" + std::to_string(irq) + ")";
+            if (b.bus.nmi() != nmi) return at + "NMI " + std::to_string(b.bus.nmi()) + " (" + std::to_string(nmi) + ")";
+            return "";
+        }
+
+        // A cpu waiting in a loop at 0200 (after SEI, if masked) while the timer interupts it every 200 cycles, and
+        // the handlers at 'nmi' and 'irq' count at 0010. Returns the count after 1050 cycles, i.e. 5 expiries.
+        auto interupts_taken(REG16 nmi, REG16 irq, REG8 control, bool masked) -> size_t
+        {
+            bench b;
+            b.bus.attach_device(std::make_unique<ram<0x0000, 0xCFFF>>(&b.bus, &b.debugger));
+            b.bus.attach_device(std::make_unique<ram<0xE000, 0xFFFF>>(&b.bus, &b.debugger));
+            b.bus.attach_device(std::make_unique<timer_device>(&b.bus, &b.debugger));
+            const std::vector<std::pair<REG16, std::vector<REG8>>> code = {
+                { 0x0200, { 0x78, 0x4C, 0x01, 0x02 } },         // SEI, JMP $0201
+                { 0x0300, { 0xEE, 0x10, 0x00, 0xAD, (REG8)(timer + 3), (REG8)(timer >> 8), 0x40 } }, // INC $0010, LDA status, RTI
+                { 0x0310, { 0xEE, 0x10, 0x00, 0x40 } },         // INC $0010, RTI
+                { 0xFFFA, { (REG8)nmi, (REG8)(nmi >> 8) } },
+                { 0xFFFE, { (REG8)irq, (REG8)(irq >> 8) } },
+            };
+            for(auto &c : code) {
+                for(size_t i = 0; i < c.second.size(); i++) {
+                    b.poke((REG16)(c.first + i), c.second[i]);
+                }
+            }
+            auto cpu = (cpu6502*)b.bus.attach_cpu(std::make_unique<cpu6502>(&b.bus, &b.debugger));
+            cpu->_registers = {};
+            cpu->_registers.S = 0xFF;
+            cpu->_registers.PC = masked ? 0x0200 : 0x0201;
+            b.poke(timer + 0, 200);
+            b.poke(timer + 1, 0);
+            b.poke(timer + 2, control);
+            tick_to(b, 1050);
+            return b.peek(0x0010);
+        }
+    }
+
+    auto check_banked_ram() -> std::string
+    {
+        const REG16 control = 0xD060;
+        typedef banked_ram<0x8000, 0x9FFF, control> banked;
+        bench b;
+        b.bus.attach_device(std::make_unique<ram<0x0000, 0x7FFF>>(&b.bus, &b.debugger));
+        auto r = (banked*)b.bus.attach_device(std::make_unique<banked>(&b.bus, &b.debugger, 16));
+
+        // At powerup window n shows bank n
+        b.poke(0x8010, 0x11);
+        b.poke(0x9010, 0x22);
+        std::string difference;
+        if (!(difference = expect(b, 0x8010, 0x11)).empty()) return "bank 0: " + difference;
+        if (!(difference = expect(b, 0x9010, 0x22)).empty()) return "bank 1: " + difference;
+        if (r->bank(0)[0x10] != 0x11 || r->bank(1)[0x10] != 0x22) return "the pool doesn't hold the windows' bytes";
+
+        // The first window onto bank 5, which is still empty, and a write through the bus into it
+        b.poke(control, 0);
+        b.poke(control + 1, 5);
+        if (b.peek(control + 1) != 5 || b.peek(control + 2) != 0) return "window 0 doesn't read back as bank 5";
+        if (!(difference = expect(b, 0x8010, 0x00)).empty()) return "bank 5: " + difference;
+        b.poke(0x8010, 0x33);
+        if (!(difference = expect(b, 0x8010, 0x33)).empty()) return "bank 5: " + difference;
+        if (r->bank(5)[0x10] != 0x33 || r->bank(0)[0x10] != 0x11) return "the write to bank 5 went to another bank";
+        if (!(difference = expect(b, 0x9010, 0x22)).empty()) return "window 1 moved with window 0: " + difference;
+
+        // Back to bank 0, then to bank 0x0105 (through the high byte), which wraps onto bank 5 of the 16
+        b.poke(control + 1, 0);
+        if (!(difference = expect(b, 0x8010, 0x11)).empty()) return "bank 0 again: " + difference;
+        b.poke(control + 1, 5);
+        b.poke(control + 2, 1);
+        if (b.peek(control + 1) != 5 || b.peek(control + 2) != 1) return "window 0 doesn't read back as bank 0105";
+        if (!(difference = expect(b, 0x8010, 0x33)).empty()) return "bank 0105: " + difference;
+
+        // Both windows onto bank 5: a write through one shows through the other
+        b.poke(control, 1);
+        b.poke(control + 1, 5);
+        b.poke(control + 2, 0);
+        b.poke(0x9020, 0x44);
+        if (!(difference = expect(b, 0x8020, 0x44)).empty()) return "shared bank: " + difference;
+        if (!(difference = expect(b, 0x9010, 0x33)).empty()) return "shared bank: " + difference;
+
+        // Powerup maps the windows back
+        b.bus.powerup();
+        if (!(difference = expect(b, 0x8010, 0x11)).empty()) return "after powerup: " + difference;
+        if (!(difference = expect(b, 0x9010, 0x22)).empty()) return "after powerup: " + difference;
+        return "";
+    }
+
+    auto check_dma_controller() -> std::string
+    {
+        typedef screen<0x0400, 0x07E7> text_screen;
+        typedef dma_controller<dma>::mode mode;
+        bench b;
+        b.bus.attach_device(std::make_unique<ram<0x0000, 0x9FFF>>(&b.bus, &b.debugger));
+        auto s = (text_screen*)b.bus.attach_device(std::make_unique<text_screen>(&b.bus, &b.debugger));
+        b.bus.attach_device(std::make_unique<dma_controller<dma>>(&b.bus, &b.debugger, 1, dma_setup_cycles));
+        for(size_t i = 0; i < 0x400; i++) {
+            b.poke((REG16)(0x1000 + i), (REG8)(i * 7 + 3));
+        }
+        auto source = [](size_t i) { return (REG8)(i * 7 + 3); };
+        std::string difference;
+
+        // Across pages, between pages plain memory backs: copied in bulk, past the debugger
+        if (!(difference = transfer(b, mode::copy, 0x1080, 0x2040, 0x200)).empty()) return "copy: " + difference;
+        for(size_t i = 0; i < 0x200; i++) {
+            if (!(difference = expect(b, (REG16)(0x2040 + i), source(0x80 + i))).empty()) return "copy: " + difference;
+        }
+        if (b.peek(0x203F) != 0 || b.peek(0x2240) != 0) return "copy: wrote outside the destination";
+        if (!b.debugger._writes.empty()) return "copy: went through the bus";
+
+        // Onto the source, one byte ahead: front to back, the first byte is copied over and over
+        if (!(difference = transfer(b, mode::copy, 0x1000, 0x1001, 0x40)).empty()) return "overlap ahead: " + difference;
+        for(size_t i = 0; i <= 0x40; i++) {
+            if (!(difference = expect(b, (REG16)(0x1000 + i), source(0))).empty()) return "overlap ahead: " + difference;
+        }
+        if (!(difference = expect(b, 0x1041, source(0x41))).empty()) return "overlap ahead: " + difference;
+
+        // Onto the source, one byte behind: every byte moves down one
+        if (!(difference = transfer(b, mode::copy, 0x1101, 0x1100, 0x40)).empty()) return "overlap behind: " + difference;
+        for(size_t i = 0; i < 0x40; i++) {
+            if (!(difference = expect(b, (REG16)(0x1100 + i), source(0x101 + i))).empty()) return "overlap behind: " + difference;
+        }
+        if (!(difference = expect(b, 0x1140, source(0x140))).empty()) return "overlap behind: " + difference;
+
+        // A fill across a page, with the value in the source's lo byte
+        if (!(difference = transfer(b, mode::fill, 0x00A5, 0x30F0, 0x20)).empty()) return "fill: " + difference;
+        for(size_t i = 0; i < 0x20; i++) {
+            if (!(difference = expect(b, (REG16)(0x30F0 + i), 0xA5)).empty()) return "fill: " + difference;
+        }
+        if (b.peek(0x30EF) != 0 || b.peek(0x3110) != 0) return "fill: wrote outside the destination";
+
+        // Into the screen, which shares its pages with the RAM: every byte through the bus, so both see it
+        if (!(difference = transfer(b, mode::copy, 0x1200, 0x0400, 0x50)).empty()) return "copy to the screen: " + difference;
+        if (b.debugger._writes.size() != 0x50) return "copy to the screen: " + std::to_string(b.debugger._writes.size()) + " bus writes (80)";
+        REG8 shown[text_screen::size];
+        s->snapshot(shown);
+        for(size_t i = 0; i < 0x50; i++) {
+            if (shown[i] != source(0x200 + i)) return describe("copy to the screen: screen", (REG16)(0x0400 + i), shown[i], source(0x200 + i));
+            if (b.peek((REG16)(0x0400 + i)) != source(0x200 + i)) return "copy to the screen: the RAM missed it";
+        }
+        if (s->dirty_rows() != 0x03) return "copy to the screen: the dirty rows aren't the first two";
+        s->clean();
+        if (!(difference = transfer(b, mode::fill, 0x002A, 0x07C0, 0x28)).empty()) return "fill the screen: " + difference;
+        if (b.debugger._writes.size() != 0x28) return "fill the screen: " + std::to_string(b.debugger._writes.size()) + " bus writes (40)";
+        s->snapshot(shown);
+        for(size_t i = 0x3C0; i < text_screen::size; i++) {
+            if (shown[i] != 0x2A) return describe("fill the screen: screen", (REG16)(0x0400 + i), shown[i], 0x2A);
+        }
+        if (s->dirty_rows() != 1u << (text_screen::rows - 1)) return "fill the screen: the dirty row isn't the last";
+        return "";
+    }
+
+    auto check_interval_timer() -> std::string
+    {
+        std::string difference;
+        {
+            // One-shot IRQ after 100 cycles, the count goes down with the cycles
+            bench b;
+            b.bus.attach_device(std::make_unique<timer_device>(&b.bus, &b.debugger));
+            b.poke(timer + 0, 100);
+            b.poke(timer + 1, 0);
+            b.poke(timer + 2, timer_device::enabled);
+            if (!(difference = expect_timer(b, 0, 100, false, false)).empty()) return "one-shot: " + difference;
+            if (!(difference = expect_timer(b, 30, 70, false, false)).empty()) return "one-shot: " + difference;
+            if (!(difference = expect_timer(b, 99, 1, false, false)).empty()) return "one-shot: " + difference;
+            if (!(difference = expect_timer(b, 100, 0, true, false)).empty()) return "one-shot: " + difference;
+            if (b.peek(timer + 2) != 0) return "one-shot: still enabled once it expired";
+            if (b.peek(timer + 3) != 0x01 || b.bus.irq()) return "one-shot: reading the status didn't clear the IRQ";
+            if (b.peek(timer + 3) != 0x00) return "one-shot: the status stayed set";
+            if (!(difference = expect_timer(b, 400, 0, false, false)).empty()) return "one-shot, expired: " + difference;
+        }
+        {
+            // Periodic NMI, reload 10 with a prescale of 4: every 40 cycles, from the cycle it started
+            bench b;
+            b.bus.attach_device(std::make_unique<timer_device>(&b.bus, &b.debugger));
+            tick_to(b, 5);
+            b.poke(timer + 0, 10);
+            b.poke(timer + 1, 0);
+            b.poke(timer + 2, timer_device::enabled | timer_device::periodic | timer_device::use_nmi | 0x20);
+            if (!(difference = expect_timer(b, 5, 10, false, false)).empty()) return "periodic: " + difference;
+            if (!(difference = expect_timer(b, 25, 5, false, false)).empty()) return "periodic: " + difference;
+            if (!(difference = expect_timer(b, 44, 0, false, false)).empty()) return "periodic: " + difference;
+            for(size_t n = 1; n <= 20; n++) {
+                auto due = 5 + 40 * n;
+                if (!(difference = expect_timer(b, due - 1, 0, false, false)).empty()) return "periodic: " + difference;
+                if (!(difference = expect_timer(b, due, 10, false, true)).empty()) return "periodic: " + difference;
+                if (b.peek(timer + 3) != 0x01 || b.bus.nmi()) return "periodic: reading the status didn't clear the NMI";
+            }
+            // Left up, the line stays up
+            if (!(difference = expect_timer(b, 5 + 40 * 22, 10, false, true)).empty()) return "periodic, left up: " + difference;
+            if (b.peek(timer + 2) != (timer_device::enabled | timer_device::periodic | timer_device::use_nmi | 0x20)) {
+                return "periodic: the control changed";
+            }
+
+            // A restart drops the pending expiry (due at 1005), disabling drops it for good
+            tick_to(b, 1000);
+            b.peek(timer + 3);
+            b.poke(timer + 2, timer_device::enabled);
+            if (!(difference = expect_timer(b, 1009, 1, false, false)).empty()) return "restart: " + difference;
+            if (!(difference = expect_timer(b, 1010, 0, true, false)).empty()) return "restart: " + difference;
+            b.peek(timer + 3);
+            b.poke(timer + 2, timer_device::enabled);
+            tick_to(b, 1015);
+            b.poke(timer + 2, 0);
+            if (!(difference = expect_timer(b, 1300, 0, false, false)).empty()) return "disabled: " + difference;
+        }
+        {
+            // A reload of 0 is 65536 cycles
+            bench b;
+            b.bus.attach_device(std::make_unique<timer_device>(&b.bus, &b.debugger));
+            b.poke(timer + 2, timer_device::enabled);
+            if (!(difference = expect_timer(b, 0xFFFF, 1, false, false)).empty()) return "reload 0: " + difference;
+            if (!(difference = expect_timer(b, 0x10000, 0, true, false)).empty()) return "reload 0: " + difference;
+        }
+
+        auto taken = interupts_taken(0x0300, 0x0300, timer_device::enabled | timer_device::periodic | timer_device::use_nmi, false);
+        if (taken != 5) return "NMI cleared by the handler: taken " + std::to_string(taken) + " times (5)";
+        taken = interupts_taken(0x0310, 0x0300, timer_device::enabled | timer_device::periodic | timer_device::use_nmi, false);
+        if (taken != 1) return "NMI left up: taken " + std::to_string(taken) + " times (1)";
+        taken = interupts_taken(0x0310, 0x0300, timer_device::enabled | timer_device::periodic, false);
+        if (taken != 5) return "IRQ: taken " + std::to_string(taken) + " times (5)";
+        taken = interupts_taken(0x0310, 0x0300, timer_device::enabled | timer_device::periodic, true);
+        if (taken != 0) return "masked IRQ: taken " + std::to_string(taken) + " times (0)";
+        return "";
+    }
+}
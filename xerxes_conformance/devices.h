@@ -0,0 +1,28 @@
+#ifndef __DEVICESH
+#define __DEVICESH
+
+#include <string>
+
+namespace dave
+{
+    // Banked RAM with two 4K windows behind plain RAM: writes a byte into each window, switches the first window to
+    // other banks (through both bank bytes) and back, and maps both windows onto the same bank. Every read, through
+    // the bus and through direct(), has to follow the window's bank. Returns what differs, empty if nothing.
+    auto check_banked_ram() -> std::string;
+
+    // The DMA controller on plain RAM, with the screen over 0400-07E7. Copies across pages, copies onto an overlapping
+    // destination on either side (the one ahead of the source has to smear the first byte, as a byte at a time loop
+    // does), fills, and copies and fills into the screen, which have to go through the bus. Every transfer has to take
+    // effect, and raise the IRQ, exactly when its cycles have passed, and reading the status clears the IRQ. Returns
+    // what differs, empty if nothing.
+    auto check_dma_controller() -> std::string;
+
+    // The interval timer without a cpu: the count as it goes down (divided by the prescale), a one-shot IRQ that
+    // disables the timer, a periodic NMI that doesn't drift, a restart that drops the pending expiry, and disabling
+    // it. Then with a cpu, taking the timer's interupts in a handler: a periodic NMI the handler clears is taken every
+    // period, one it leaves up only once (the NMI is edge triggered), an IRQ every period, and a masked IRQ never.
+    // Returns what differs, empty if nothing.
+    auto check_interval_timer() -> std::string;
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "fuzzer.h"
+
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "../xerxes_lib/ram.h"
+
+namespace dave
+{
+    fuzzer::machine::machine()
+    : bus(&debugger, irq, nmi)
+    {
+        bus.attach_device(std::make_unique<ram<0x0000, 0xFFFF>>(&bus, &debugger));
+    }
+
+    namespace
+    {
+        auto hex(unsigned int value, int width) -> std::string
+        {
+            std::ostringstream stm;
+            stm << std::hex << std::uppercase << std::setfill('0') << std::setw(width) << value;
+            return stm.str();
+        }
+
+        auto status(const cpu6502::registers &regs) -> REG8
+        {
+            // B and the unused bit don't exist in the register
+            return *((REG8*)&regs.P) & 0xCF;
+        }
+    }
+
+    auto fuzzer::run(uint64_t seed, size_t instructions) -> fuzz_result
+    {
+        // Random memory, 8 bytes at a time, the same for both
+        std::mt19937_64 random(seed);
+        for(size_t page = 0; page < 256; page++) {
+            auto ref = _ref.bus.direct((REG8)page);
+            for(size_t i = 0; i < 256; i += 8) {
+                uint64_t v = random();
+                memcpy(ref + i, &v, 8);
+            }
+            memcpy(_cand.bus.direct((REG8)page), ref, 256);
+        }
+
+        _ref.cpu = _reference.create(&_ref.bus, &_ref.debugger);
+        _cand.cpu = _candidate.create(&_cand.bus, &_cand.debugger);
+        uint64_t v = random();
+        auto &regs = _ref.cpu->_registers;
+        regs.PC = (REG16)v;
+        regs.A = (REG8)(v >> 16);
+        regs.X = (REG8)(v >> 24);
+        regs.Y = (REG8)(v >> 32);
+        regs.S = (REG8)(v >> 40);
+        *((REG8*)&regs.P) = (REG8)(v >> 48);
+        _cand.cpu->_registers = regs;
+
+        fuzz_result result;
+        auto &cand = _cand.cpu->_registers;
+        while(result.instructions < instructions) {
+            auto pc = regs.PC;
+            auto op = _ref.bus.direct(pc >> 8)[pc & 0xFF];
+            // WAI and STP put the cpus to sleep, nothing runs after them
+            if (op == 0xCB || op == 0xDB) break;
+            result.instructions++;
+            auto ref_cycles = step_instruction(_ref.cpu.get(), _ref.debugger, false);
+            auto cand_cycles = step_instruction(_cand.cpu.get(), _cand.debugger, true);
+            if (cand.PC == regs.PC && cand.A == regs.A && cand.X == regs.X && cand.Y == regs.Y && cand.S == regs.S
+                && status(cand) == status(regs) && _cand.debugger._writes == _ref.debugger._writes && cand_cycles == ref_cycles) {
+                continue;
+            }
+
+            // Describe the difference
+            std::ostringstream stm;
+            auto check = [&stm](const char *name, unsigned int value, unsigned int expected, int width) {
+                if (value != expected) {
+                    stm << " " << name << "=" << hex(value, width) << " (" << hex(expected, width) << ")";
+                }
+            };
+            check("PC", cand.PC, regs.PC, 4);
+            check("A", cand.A, regs.A, 2);
+            check("X", cand.X, regs.X, 2);
+            check("Y", cand.Y, regs.Y, 2);
+            check("S", cand.S, regs.S, 2);
+            check("P", status(cand), status(regs), 2);
+            if (_cand.debugger._writes != _ref.debugger._writes) {
+                stm << " writes";
+                for(auto &w : _cand.debugger._writes) stm << " [" << hex(w.first, 4) << "]=" << hex(w.second, 2);
+                stm << " (";
+                for(auto &w : _ref.debugger._writes) stm << " [" << hex(w.first, 4) << "]=" << hex(w.second, 2);
+                stm << " )";
+            }
+            if (cand_cycles != ref_cycles) {
+                stm << " cycles=" << cand_cycles << " (" << ref_cycles << ")";
+            }
+            result.difference = hex(op, 2) + " at " + hex(pc, 4) + ":" + stm.str();
+            break;
+        }
+        return result;
+    }
+}
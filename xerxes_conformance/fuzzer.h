@@ -0,0 +1,50 @@
+#ifndef __FUZZERH
+#define __FUZZERH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../xerxes_lib/system_bus.h"
+#include "cores.h"
+
+namespace dave
+{
+    struct fuzz_result {
+        size_t instructions = 0; // the instructions run, up to and including the one that differed
+        std::string difference;  // empty if the cores agreed on every instruction
+    };
+
+    // Runs a reference core and a candidate core side by side, an instruction at a time, from the same random memory
+    // and registers. The reference is stepped cycle by cycle through tick(), the candidate through run(), the way the
+    // bus runs it. Stops at the first instruction after which the registers, the bus writes or the cycles differ.
+    class fuzzer {
+    private:
+        struct machine {
+            bool irq = false;
+            bool nmi = false;
+            step_debugger debugger;
+            system_bus bus;
+            std::unique_ptr<cpu6502> cpu;
+            machine();
+        };
+        const core &_reference;
+        const core &_candidate;
+        machine _ref;
+        machine _cand;
+    public:
+        fuzzer(const core &reference, const core &candidate)
+        : _reference(reference), _candidate(candidate)
+        {}
+
+        fuzzer(const fuzzer&) = delete;
+        fuzzer(fuzzer &&) = delete;
+        auto operator =(const fuzzer&)->fuzzer& = delete;
+        auto operator =(fuzzer &&)->fuzzer& = delete;
+
+        // The same seed gives the same sequence
+        auto run(uint64_t seed, size_t instructions) -> fuzz_result;
+    };
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include "multi_cpu.h"
+
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "../xerxes_lib/system_bus.h"
+#include "../xerxes_lib/cpu6502.h"
+#include "../xerxes_lib/ram.h"
+#include "step_debugger.h"
+
+namespace dave
+{
+    namespace
+    {
+        // A bus write, stamped with the bus cycle it happened in
+        typedef std::tuple<size_t, REG16, REG8> stamped_write;
+
+        // Lets the cpu's run freely, and logs every bus write with the bus cycle. The cpu threads of a parallel run
+        // write to the log in turn.
+        class write_log_debugger : public step_debugger {
+        private:
+            std::mutex _lock;
+        public:
+            system_bus *bus = nullptr;
+            std::vector<stamped_write> log;
+
+            virtual bool break_on_next_instruction_ready(const REG16 &next_instruction_addr) override { return false; }
+            virtual bool break_on_stop(const REG16 &addr) override { return false; }
+            virtual void report_address_write(const REG16 &addr, const REG8 *data) override {
+                std::lock_guard<std::mutex> guard(_lock);
+                log.push_back(std::make_tuple(bus->now(), addr, *data));
+            }
+        };
+
+        struct machine {
+            bool irq = false;
+            bool nmi = false;
+            write_log_debugger debugger;
+            system_bus bus;
+            std::vector<cpu6502*> cpus;
+
+            machine()
+            : bus(&debugger, irq, nmi)
+            {
+                debugger.bus = &bus;
+                bus.attach_device(std::make_unique<ram<0x0000, 0xFFFF>>(&bus, &debugger));
+            }
+
+            void load(REG16 address, const std::vector<REG8> &program) {
+                for(size_t i = 0; i < program.size(); i++) {
+                    auto a = (REG16)(address + i);
+                    bus.direct((REG8)(a >> 8))[a & 0xFF] = program[i];
+                }
+            }
+
+            // A cpu with its first instruction, at 'pc', ready to run
+            void add_cpu(size_t budget, REG16 pc) {
+                auto cpu = (cpu6502*)bus.attach_cpu(std::make_unique<cpu6502>(&bus, &debugger), budget);
+                cpu->_registers = {};
+                cpu->_registers.PC = pc;
+                cpus.push_back(cpu);
+            }
+        };
+
+        // 'INC counter; JMP code', 9 cycles a turn
+        auto inc_loop(REG16 code, REG16 counter) -> std::vector<REG8>
+        {
+            return {
+                0xEE, (REG8)counter, (REG8)(counter >> 8),
+                0x4C, (REG8)code, (REG8)(code >> 8),
+            };
+        }
+
+        // 'INC counter' until it is 'last', then STP
+        auto count_to(REG16 code, REG16 counter, REG8 last) -> std::vector<REG8>
+        {
+            return {
+                0xEE, (REG8)counter, (REG8)(counter >> 8),
+                0xAD, (REG8)counter, (REG8)(counter >> 8),
+                0xC9, last,
+                0xD0, 0xF6,
+                0xDB,
+            };
+        }
+
+        auto status(const cpu6502::registers &regs) -> REG8
+        {
+            return *((REG8*)&regs.P);
+        }
+
+        auto describe(const cpu6502::registers &regs) -> std::string
+        {
+            std::ostringstream stm;
+            stm << std::hex << "PC=" << regs.PC << " A=" << (unsigned int)regs.A << " X=" << (unsigned int)regs.X
+                << " Y=" << (unsigned int)regs.Y << " S=" << (unsigned int)regs.S << " P=" << (unsigned int)status(regs);
+            return stm.str();
+        }
+
+        // The difference between the cpu's and the pages of two machines, empty if there is none
+        auto compare(machine &m, machine &expected, const std::vector<REG8> &pages) -> std::string
+        {
+            for(size_t c = 0; c < m.cpus.size(); c++) {
+                auto &regs = m.cpus[c]->_registers;
+                auto &exp = expected.cpus[c]->_registers;
+                if (regs.PC != exp.PC || regs.A != exp.A || regs.X != exp.X || regs.Y != exp.Y || regs.S != exp.S
+                    || status(regs) != status(exp) || m.cpus[c]->asleep() != expected.cpus[c]->asleep()) {
+                    return "cpu " + std::to_string(c) + ": " + describe(regs) + " (" + describe(exp) + ")";
+                }
+            }
+            for(auto page : pages) {
+                if (memcmp(m.bus.direct(page), expected.bus.direct(page), 256) != 0) {
+                    std::ostringstream stm;
+                    stm << "page " << std::hex << (unsigned int)page << " differs";
+                    return stm.str();
+                }
+            }
+            return "";
+        }
+
+        const size_t loop_cycles = 9;
+
+        auto describe(const stamped_write &w) -> std::string
+        {
+            std::ostringstream stm;
+            stm << "cycle " << std::get<0>(w) << " " << std::hex << std::get<1>(w) << "=" << (unsigned int)std::get<2>(w);
+            return stm.str();
+        }
+    }
+
+    auto check_rounds(size_t rounds) -> std::string
+    {
+        const size_t quantum = 5;
+        const size_t budgets[] = { 1, 3 };
+        const REG16 codes[] = { 0x0200, 0x0300 };
+        const REG16 counters[] = { 0x1000, 0x1001 };
+
+        machine m;
+        m.bus.quantum(quantum);
+        for(size_t c = 0; c < 2; c++) {
+            m.load(codes[c], inc_loop(codes[c], counters[c]));
+            m.add_cpu(budgets[c], codes[c]);
+        }
+        for(size_t r = 0; r < rounds; r++) {
+            if (m.bus.tick()) return "a cpu broke in round " + std::to_string(r);
+        }
+
+        // In round r the devices tick first, the writes are all stamped with the end of the round. Then every cpu runs
+        // its cycles for the round in turn, and its INC writes on every cycle that starts a turn of its loop.
+        std::vector<stamped_write> expected;
+        size_t count[2] = {};
+        for(size_t r = 0; r < rounds; r++) {
+            for(size_t c = 0; c < 2; c++) {
+                auto cycles = budgets[c] * quantum;
+                for(size_t cycle = r * cycles; cycle < (r + 1) * cycles; cycle++) {
+                    if (cycle % loop_cycles == 0) {
+                        expected.push_back(std::make_tuple((r + 1) * quantum, counters[c], (REG8)++count[c]));
+                    }
+                }
+            }
+        }
+
+        auto &log = m.debugger.log;
+        for(size_t i = 0; i < expected.size() && i < log.size(); i++) {
+            if (log[i] != expected[i]) {
+                return "write " + std::to_string(i) + ": " + describe(log[i]) + " (" + describe(expected[i]) + ")";
+            }
+        }
+        if (log.size() != expected.size()) {
+            return std::to_string(log.size()) + " writes (" + std::to_string(expected.size()) + ")";
+        }
+        return "";
+    }
+
+    auto check_parallel(size_t rounds) -> std::string
+    {
+        // Each cpu in its own pages, the rounds run the whole quantum, the same as serially
+        {
+            const size_t budgets[] = { 1, 2 };
+            const REG16 codes[] = { 0x0200, 0x0300 };
+            const REG16 counters[] = { 0x1000, 0x1100 };
+            machine serial, parallel;
+            for(auto m : { &serial, &parallel }) {
+                m->bus.quantum(system_bus::parallel_quantum);
+                for(size_t c = 0; c < 2; c++) {
+                    m->load(codes[c], inc_loop(codes[c], counters[c]));
+                    m->add_cpu(budgets[c], codes[c]);
+                }
+            }
+            parallel.bus.parallel(true);
+            for(size_t r = 0; r < rounds; r++) {
+                if (serial.bus.tick() || parallel.bus.tick()) return "a cpu broke in round " + std::to_string(r);
+            }
+            if (parallel.bus.now() != serial.bus.now()) {
+                return "own pages: cycle " + std::to_string(parallel.bus.now()) + " (" + std::to_string(serial.bus.now()) + ")";
+            }
+            auto difference = compare(parallel, serial, { 0x02, 0x03, 0x10, 0x11 });
+            if (!difference.empty()) return "own pages: " + difference;
+        }
+
+        // Both cpu's count in the same page, the rounds end early, but they both get there
+        {
+            const REG16 codes[] = { 0x0200, 0x0300 };
+            const REG16 counters[] = { 0x1000, 0x1001 };
+            const REG8 last = 200;
+            machine serial, parallel;
+            for(auto m : { &serial, &parallel }) {
+                m->bus.quantum(system_bus::parallel_quantum);
+                for(size_t c = 0; c < 2; c++) {
+                    m->load(codes[c], count_to(codes[c], counters[c], last));
+                    m->add_cpu(1, codes[c]);
+                }
+            }
+            parallel.bus.parallel(true);
+            for(auto m : { &serial, &parallel }) {
+                for(size_t r = 0; r < rounds && !(m->cpus[0]->asleep() && m->cpus[1]->asleep()); r++) {
+                    if (m->bus.tick()) return "a cpu broke in round " + std::to_string(r);
+                }
+            }
+            if (!serial.cpus[0]->asleep() || !serial.cpus[1]->asleep()) return "shared page: the serial run didn't stop";
+            auto difference = compare(parallel, serial, { 0x02, 0x03, 0x10 });
+            if (!difference.empty()) return "shared page: " + difference;
+        }
+        return "";
+    }
+}
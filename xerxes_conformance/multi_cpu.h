@@ -0,0 +1,20 @@
+#ifndef __MULTI_CPUH
+#define __MULTI_CPUH
+
+#include <cstdint>
+#include <string>
+
+namespace dave
+{
+    // Runs two cpu's on one bus with uneven budgets (1 and 3) and a quantum of 5, each incrementing its own counter in
+    // a loop. Every write is stamped with the bus cycle, and the log must match the rounds exactly: in every round the
+    // first cpu's writes for its 5 cycles, then the second cpu's for its 15. Returns what differs, empty if nothing.
+    auto check_rounds(size_t rounds) -> std::string;
+
+    // Runs two cpu's serially and in parallel mode, for up to this many rounds of system_bus::parallel_quantum cycles,
+    // and compares the memory and the registers. Once when each cpu keeps to its own pages, and once when they both count to 200 in the same
+    // page and stop. Returns what differs, empty if nothing.
+    auto check_parallel(size_t rounds) -> std::string;
+}
+
+#endif
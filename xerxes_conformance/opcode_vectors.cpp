@@ -0,0 +1,314 @@
+#include "opcode_vectors.h"
+
+namespace dave
+{
+    namespace
+    {
+        // Status register bits
+        const REG8 C = 0x01, Z = 0x02, I = 0x04, D = 0x08, B = 0x10, U = 0x20, V = 0x40, N = 0x80;
+        const REG8 P0 = B | U;
+
+        // The instructions start at 0x0200, the stack at 0x01FD. Memory operands are in page zero at 0x10 (pointers
+        // at 0x10/0x11), and at 0x1234. Indexed modes that cross a page land on 0x1334 (or 0x1310 via page zero).
+        const std::vector<opcode_vector> vectors = {
+            // ADC
+            { "adc #", { 0x0200, 0x10, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x69}, {0x0201, 0x22} } }, { 0x0202, 0x32, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "adc # (carry in)", { 0x0200, 0x01, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x69}, {0x0201, 0x01} } }, { 0x0202, 0x03, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "adc # (carry out)", { 0x0200, 0xFF, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x69}, {0x0201, 0x01} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 2 },
+            { "adc # (overflow)", { 0x0200, 0x50, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x69}, {0x0201, 0x50} } }, { 0x0202, 0xA0, 0x00, 0x00, 0xFD, P0 | N | V, {} }, 2 },
+            { "adc # (negative overflow)", { 0x0200, 0x80, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x69}, {0x0201, 0xFF} } }, { 0x0202, 0x7F, 0x00, 0x00, 0xFD, P0 | V | C, {} }, 2 },
+            { "adc abs", { 0x0200, 0x03, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x6D}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x08, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+            { "adc zpg", { 0x0200, 0x03, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x65}, {0x0201, 0x10}, {0x0010, 0x05} } }, { 0x0202, 0x08, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "adc (zpg,x)", { 0x0200, 0x03, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x61}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x05} } }, { 0x0202, 0x08, 0x02, 0x00, 0xFD, P0, {} }, 6 },
+            { "adc (zpg),y", { 0x0200, 0x03, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x71}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12}, {0x1234, 0x05} } }, { 0x0202, 0x08, 0x00, 0x04, 0xFD, P0, {} }, 5 },
+            { "adc (zpg),y (page crossed)", { 0x0200, 0x03, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x71}, {0x0201, 0x10}, {0x0010, 0xF0}, {0x0011, 0x12}, {0x1334, 0x05} } }, { 0x0202, 0x08, 0x00, 0x44, 0xFD, P0, {} }, 6 },
+            { "adc zpg,x", { 0x0200, 0x03, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x75}, {0x0201, 0x0E}, {0x0010, 0x05} } }, { 0x0202, 0x08, 0x02, 0x00, 0xFD, P0, {} }, 4 },
+            { "adc zpg,x (wraps)", { 0x0200, 0x03, 0x20, 0x00, 0xFD, P0, { {0x0200, 0x75}, {0x0201, 0xF0}, {0x0010, 0x05} } }, { 0x0202, 0x08, 0x20, 0x00, 0xFD, P0, {} }, 4 },
+            { "adc abs,x", { 0x0200, 0x03, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x7D}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x08, 0x04, 0x00, 0xFD, P0, {} }, 4 },
+            { "adc abs,x (page crossed)", { 0x0200, 0x03, 0x44, 0x00, 0xFD, P0, { {0x0200, 0x7D}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x05} } }, { 0x0203, 0x08, 0x44, 0x00, 0xFD, P0, {} }, 5 },
+            { "adc abs,y", { 0x0200, 0x03, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x79}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x08, 0x00, 0x04, 0xFD, P0, {} }, 4 },
+            { "adc abs,y (page crossed)", { 0x0200, 0x03, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x79}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x05} } }, { 0x0203, 0x08, 0x00, 0x44, 0xFD, P0, {} }, 5 },
+            { "adc (zpg)", { 0x0200, 0x03, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x72}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x05} } }, { 0x0202, 0x08, 0x00, 0x00, 0xFD, P0, {} }, 5 },
+            { "adc # (decimal)", { 0x0200, 0x46, 0x00, 0x00, 0xFD, P0 | D | C, { {0x0200, 0x69}, {0x0201, 0x12} } }, { 0x0202, 0x59, 0x00, 0x00, 0xFD, P0 | D, {} }, 3 },
+            { "adc # (decimal, carry out)", { 0x0200, 0x58, 0x00, 0x00, 0xFD, P0 | D | C, { {0x0200, 0x69}, {0x0201, 0x46} } }, { 0x0202, 0x05, 0x00, 0x00, 0xFD, P0 | D | V | C, {} }, 3 },
+            { "adc # (decimal, zero)", { 0x0200, 0x99, 0x00, 0x00, 0xFD, P0 | D, { {0x0200, 0x69}, {0x0201, 0x01} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | D | Z | C, {} }, 3 },
+            { "adc zpg (decimal)", { 0x0200, 0x25, 0x00, 0x00, 0xFD, P0 | D, { {0x0200, 0x65}, {0x0201, 0x10}, {0x0010, 0x48} } }, { 0x0202, 0x73, 0x00, 0x00, 0xFD, P0 | D, {} }, 4 },
+
+            // SBC
+            { "sbc #", { 0x0200, 0x50, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xE9}, {0x0201, 0x20} } }, { 0x0202, 0x30, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "sbc # (borrow in)", { 0x0200, 0x05, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xE9}, {0x0201, 0x05} } }, { 0x0202, 0xFF, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "sbc # (borrow out)", { 0x0200, 0x20, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xE9}, {0x0201, 0x30} } }, { 0x0202, 0xF0, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "sbc # (zero)", { 0x0200, 0x05, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xE9}, {0x0201, 0x05} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 2 },
+            { "sbc # (overflow)", { 0x0200, 0x80, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xE9}, {0x0201, 0x01} } }, { 0x0202, 0x7F, 0x00, 0x00, 0xFD, P0 | V | C, {} }, 2 },
+            { "sbc abs", { 0x0200, 0x08, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xED}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x03, 0x00, 0x00, 0xFD, P0 | C, {} }, 4 },
+            { "sbc zpg", { 0x0200, 0x08, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xE5}, {0x0201, 0x10}, {0x0010, 0x05} } }, { 0x0202, 0x03, 0x00, 0x00, 0xFD, P0 | C, {} }, 3 },
+            { "sbc (zpg,x)", { 0x0200, 0x08, 0x02, 0x00, 0xFD, P0 | C, { {0x0200, 0xE1}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x05} } }, { 0x0202, 0x03, 0x02, 0x00, 0xFD, P0 | C, {} }, 6 },
+            { "sbc (zpg),y", { 0x0200, 0x08, 0x00, 0x04, 0xFD, P0 | C, { {0x0200, 0xF1}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12}, {0x1234, 0x05} } }, { 0x0202, 0x03, 0x00, 0x04, 0xFD, P0 | C, {} }, 5 },
+            { "sbc (zpg),y (page crossed)", { 0x0200, 0x08, 0x00, 0x44, 0xFD, P0 | C, { {0x0200, 0xF1}, {0x0201, 0x10}, {0x0010, 0xF0}, {0x0011, 0x12}, {0x1334, 0x05} } }, { 0x0202, 0x03, 0x00, 0x44, 0xFD, P0 | C, {} }, 6 },
+            { "sbc zpg,x", { 0x0200, 0x08, 0x02, 0x00, 0xFD, P0 | C, { {0x0200, 0xF5}, {0x0201, 0x0E}, {0x0010, 0x05} } }, { 0x0202, 0x03, 0x02, 0x00, 0xFD, P0 | C, {} }, 4 },
+            { "sbc abs,x", { 0x0200, 0x08, 0x04, 0x00, 0xFD, P0 | C, { {0x0200, 0xFD}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x03, 0x04, 0x00, 0xFD, P0 | C, {} }, 4 },
+            { "sbc abs,x (page crossed)", { 0x0200, 0x08, 0x44, 0x00, 0xFD, P0 | C, { {0x0200, 0xFD}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x05} } }, { 0x0203, 0x03, 0x44, 0x00, 0xFD, P0 | C, {} }, 5 },
+            { "sbc abs,y", { 0x0200, 0x08, 0x00, 0x04, 0xFD, P0 | C, { {0x0200, 0xF9}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x03, 0x00, 0x04, 0xFD, P0 | C, {} }, 4 },
+            { "sbc (zpg)", { 0x0200, 0x08, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xF2}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x05} } }, { 0x0202, 0x03, 0x00, 0x00, 0xFD, P0 | C, {} }, 5 },
+            { "sbc # (decimal)", { 0x0200, 0x46, 0x00, 0x00, 0xFD, P0 | D | C, { {0x0200, 0xE9}, {0x0201, 0x12} } }, { 0x0202, 0x34, 0x00, 0x00, 0xFD, P0 | D | C, {} }, 3 },
+            { "sbc # (decimal, borrow in)", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0 | D, { {0x0200, 0xE9}, {0x0201, 0x13} } }, { 0x0202, 0x26, 0x00, 0x00, 0xFD, P0 | D | C, {} }, 3 },
+            { "sbc # (decimal, borrow out)", { 0x0200, 0x12, 0x00, 0x00, 0xFD, P0 | D | C, { {0x0200, 0xE9}, {0x0201, 0x21} } }, { 0x0202, 0x91, 0x00, 0x00, 0xFD, P0 | D | N, {} }, 3 },
+            { "sbc abs,x (decimal, page crossed)", { 0x0200, 0x50, 0x44, 0x00, 0xFD, P0 | D | C, { {0x0200, 0xFD}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x01} } }, { 0x0203, 0x49, 0x44, 0x00, 0xFD, P0 | D | C, {} }, 6 },
+
+            // AND
+            { "and #", { 0x0200, 0xF0, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x29}, {0x0201, 0x3C} } }, { 0x0202, 0x30, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "and # (zero)", { 0x0200, 0xF0, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x29}, {0x0201, 0x0F} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "and # (negative)", { 0x0200, 0xFF, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x29}, {0x0201, 0x80} } }, { 0x0202, 0x80, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "and abs", { 0x0200, 0xF0, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x2D}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x3C} } }, { 0x0203, 0x30, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+            { "and zpg", { 0x0200, 0xF0, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x25}, {0x0201, 0x10}, {0x0010, 0x3C} } }, { 0x0202, 0x30, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "and (zpg,x)", { 0x0200, 0xF0, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x21}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x3C} } }, { 0x0202, 0x30, 0x02, 0x00, 0xFD, P0, {} }, 6 },
+            { "and (zpg),y", { 0x0200, 0xF0, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x31}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12}, {0x1234, 0x3C} } }, { 0x0202, 0x30, 0x00, 0x04, 0xFD, P0, {} }, 5 },
+            { "and zpg,x", { 0x0200, 0xF0, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x35}, {0x0201, 0x0E}, {0x0010, 0x3C} } }, { 0x0202, 0x30, 0x02, 0x00, 0xFD, P0, {} }, 4 },
+            { "and abs,x", { 0x0200, 0xF0, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x3D}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x3C} } }, { 0x0203, 0x30, 0x04, 0x00, 0xFD, P0, {} }, 4 },
+            { "and abs,y (page crossed)", { 0x0200, 0xF0, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x39}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x3C} } }, { 0x0203, 0x30, 0x00, 0x44, 0xFD, P0, {} }, 5 },
+            { "and (zpg)", { 0x0200, 0xF0, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x32}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x3C} } }, { 0x0202, 0x30, 0x00, 0x00, 0xFD, P0, {} }, 5 },
+
+            // ORA
+            { "ora #", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x09}, {0x0201, 0xA0} } }, { 0x0202, 0xAF, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "ora # (zero)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x09}, {0x0201, 0x00} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "ora abs", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x0D}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0xA0} } }, { 0x0203, 0xAF, 0x00, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "ora zpg", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x05}, {0x0201, 0x10}, {0x0010, 0xA0} } }, { 0x0202, 0xAF, 0x00, 0x00, 0xFD, P0 | N, {} }, 3 },
+            { "ora (zpg,x)", { 0x0200, 0x0F, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x01}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0xA0} } }, { 0x0202, 0xAF, 0x02, 0x00, 0xFD, P0 | N, {} }, 6 },
+            { "ora (zpg),y (page crossed)", { 0x0200, 0x0F, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x11}, {0x0201, 0x10}, {0x0010, 0xF0}, {0x0011, 0x12}, {0x1334, 0xA0} } }, { 0x0202, 0xAF, 0x00, 0x44, 0xFD, P0 | N, {} }, 6 },
+            { "ora zpg,x", { 0x0200, 0x0F, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x15}, {0x0201, 0x0E}, {0x0010, 0xA0} } }, { 0x0202, 0xAF, 0x02, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "ora abs,x (page crossed)", { 0x0200, 0x0F, 0x44, 0x00, 0xFD, P0, { {0x0200, 0x1D}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0xA0} } }, { 0x0203, 0xAF, 0x44, 0x00, 0xFD, P0 | N, {} }, 5 },
+            { "ora abs,y", { 0x0200, 0x0F, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x19}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0xA0} } }, { 0x0203, 0xAF, 0x00, 0x04, 0xFD, P0 | N, {} }, 4 },
+            { "ora (zpg)", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x12}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0xA0} } }, { 0x0202, 0xAF, 0x00, 0x00, 0xFD, P0 | N, {} }, 5 },
+
+            // EOR
+            { "eor #", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x49}, {0x0201, 0xFF} } }, { 0x0202, 0xF0, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "eor # (zero)", { 0x0200, 0xFF, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x49}, {0x0201, 0xFF} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "eor abs", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x4D}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0xFF} } }, { 0x0203, 0xF0, 0x00, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "eor zpg", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x45}, {0x0201, 0x10}, {0x0010, 0xFF} } }, { 0x0202, 0xF0, 0x00, 0x00, 0xFD, P0 | N, {} }, 3 },
+            { "eor (zpg,x)", { 0x0200, 0x0F, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x41}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0xFF} } }, { 0x0202, 0xF0, 0x02, 0x00, 0xFD, P0 | N, {} }, 6 },
+            { "eor (zpg),y", { 0x0200, 0x0F, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x51}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12}, {0x1234, 0xFF} } }, { 0x0202, 0xF0, 0x00, 0x04, 0xFD, P0 | N, {} }, 5 },
+            { "eor zpg,x", { 0x0200, 0x0F, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x55}, {0x0201, 0x0E}, {0x0010, 0xFF} } }, { 0x0202, 0xF0, 0x02, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "eor abs,x", { 0x0200, 0x0F, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x5D}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0xFF} } }, { 0x0203, 0xF0, 0x04, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "eor abs,y (page crossed)", { 0x0200, 0x0F, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x59}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0xFF} } }, { 0x0203, 0xF0, 0x00, 0x44, 0xFD, P0 | N, {} }, 5 },
+            { "eor (zpg)", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x52}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0xFF} } }, { 0x0202, 0xF0, 0x00, 0x00, 0xFD, P0 | N, {} }, 5 },
+
+            // ASL
+            { "asl a", { 0x0200, 0x81, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x0A} } }, { 0x0201, 0x02, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "asl zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x06}, {0x0201, 0x10}, {0x0010, 0x40} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0010, 0x80} } }, 5 },
+            { "asl zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x16}, {0x0201, 0x0E}, {0x0010, 0x80} } }, { 0x0202, 0x00, 0x02, 0x00, 0xFD, P0 | Z | C, { {0x0010, 0x00} } }, 6 },
+            { "asl abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x0E}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x21} } }, { 0x0203, 0x00, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 6 },
+            { "asl abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x1E}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x21} } }, { 0x0203, 0x00, 0x04, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 6 },
+            { "asl abs,x (page crossed)", { 0x0200, 0x00, 0x44, 0x00, 0xFD, P0, { {0x0200, 0x1E}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x21} } }, { 0x0203, 0x00, 0x44, 0x00, 0xFD, P0, { {0x1334, 0x42} } }, 7 },
+
+            // LSR
+            { "lsr a", { 0x0200, 0x01, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x4A} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 2 },
+            { "lsr zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0200, 0x46}, {0x0201, 0x10}, {0x0010, 0x82} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0010, 0x41} } }, 5 },
+            { "lsr zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x56}, {0x0201, 0x0E}, {0x0010, 0x03} } }, { 0x0202, 0x00, 0x02, 0x00, 0xFD, P0 | C, { {0x0010, 0x01} } }, 6 },
+            { "lsr abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x4E}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x21} } }, 6 },
+            { "lsr abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x5E}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x04, 0x00, 0xFD, P0, { {0x1234, 0x21} } }, 6 },
+
+            // ROL
+            { "rol a", { 0x0200, 0x80, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x2A} } }, { 0x0201, 0x01, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "rol zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x26}, {0x0201, 0x10}, {0x0010, 0x40} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0010, 0x80} } }, 5 },
+            { "rol zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x36}, {0x0201, 0x0E}, {0x0010, 0x80} } }, { 0x0202, 0x00, 0x02, 0x00, 0xFD, P0 | Z | C, { {0x0010, 0x00} } }, 6 },
+            { "rol abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x2E}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x21} } }, { 0x0203, 0x00, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x43} } }, 6 },
+            { "rol abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0 | C, { {0x0200, 0x3E}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x21} } }, { 0x0203, 0x00, 0x04, 0x00, 0xFD, P0, { {0x1234, 0x43} } }, 6 },
+
+            // ROR
+            { "ror a", { 0x0200, 0x01, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x6A} } }, { 0x0201, 0x80, 0x00, 0x00, 0xFD, P0 | N | C, {} }, 2 },
+            { "ror zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x66}, {0x0201, 0x10}, {0x0010, 0x02} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0010, 0x01} } }, 5 },
+            { "ror zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x76}, {0x0201, 0x0E}, {0x0010, 0x01} } }, { 0x0202, 0x00, 0x02, 0x00, 0xFD, P0 | Z | C, { {0x0010, 0x00} } }, 6 },
+            { "ror abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x6E}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x1234, 0xA1} } }, 6 },
+            { "ror abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0 | C, { {0x0200, 0x7E}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x04, 0x00, 0xFD, P0 | N, { {0x1234, 0xA1} } }, 6 },
+
+            // Branches
+            { "bcc (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x90}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "bcc (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x90}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "bcc (taken, page crossed)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x90}, {0x0201, 0xFC} } }, { 0x01FE, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+            { "bcs (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xB0}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "bcs (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0xB0}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0 | C, {} }, 3 },
+            { "beq (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xF0}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "beq (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | Z, { {0x0200, 0xF0}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 3 },
+            { "bmi (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x30}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "bmi (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0200, 0x30}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0 | N, {} }, 3 },
+            { "bne (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | Z, { {0x0200, 0xD0}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "bne (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xD0}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "bpl (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0200, 0x10}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "bpl (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x10}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "bvc (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | V, { {0x0200, 0x50}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | V, {} }, 2 },
+            { "bvc (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x50}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "bvs (not taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x70}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "bvs (taken)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | V, { {0x0200, 0x70}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0 | V, {} }, 3 },
+            { "bra", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x80}, {0x0201, 0x10} } }, { 0x0212, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "bra (to itself)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x80}, {0x0201, 0xFE} } }, { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "bra (page crossed)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x80}, {0x0201, 0xFC} } }, { 0x01FE, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+
+            // BIT
+            { "bit #", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0 | N | V, { {0x0200, 0x89}, {0x0201, 0xF0} } }, { 0x0202, 0x0F, 0x00, 0x00, 0xFD, P0 | N | V | Z, {} }, 2 },
+            { "bit zpg", { 0x0200, 0x01, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x24}, {0x0201, 0x10}, {0x0010, 0xC0} } }, { 0x0202, 0x01, 0x00, 0x00, 0xFD, P0 | N | V | Z, {} }, 3 },
+            { "bit abs", { 0x0200, 0x01, 0x00, 0x00, 0xFD, P0 | N | V | Z, { {0x0200, 0x2C}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x01} } }, { 0x0203, 0x01, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+            { "bit zpg,x", { 0x0200, 0x01, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x34}, {0x0201, 0x0E}, {0x0010, 0x40} } }, { 0x0202, 0x01, 0x02, 0x00, 0xFD, P0 | V | Z, {} }, 4 },
+            { "bit abs,x", { 0x0200, 0x01, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x3C}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x81} } }, { 0x0203, 0x01, 0x04, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "bit abs,x (page crossed)", { 0x0200, 0x01, 0x44, 0x00, 0xFD, P0, { {0x0200, 0x3C}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x81} } }, { 0x0203, 0x01, 0x44, 0x00, 0xFD, P0 | N, {} }, 5 },
+
+            // Flags
+            { "clc", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | C, { {0x0200, 0x18} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "cld", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | D, { {0x0200, 0xD8} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "cli", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | I, { {0x0200, 0x58} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "clv", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0 | V, { {0x0200, 0xB8} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "sec", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x38} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "sed", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xF8} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | D, {} }, 2 },
+            { "sei", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x78} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | I, {} }, 2 },
+
+            // CMP, CPX, CPY
+            { "cmp # (equal)", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC9}, {0x0201, 0x40} } }, { 0x0202, 0x40, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 2 },
+            { "cmp # (less)", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC9}, {0x0201, 0x41} } }, { 0x0202, 0x40, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "cmp # (greater)", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC9}, {0x0201, 0x30} } }, { 0x0202, 0x40, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "cmp # (less, signs differ)", { 0x0200, 0x10, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC9}, {0x0201, 0x90} } }, { 0x0202, 0x10, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "cmp # (greater, signs differ)", { 0x0200, 0x80, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC9}, {0x0201, 0x01} } }, { 0x0202, 0x80, 0x00, 0x00, 0xFD, P0 | C, {} }, 2 },
+            { "cmp abs", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xCD}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x40} } }, { 0x0203, 0x40, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 4 },
+            { "cmp zpg", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC5}, {0x0201, 0x10}, {0x0010, 0x40} } }, { 0x0202, 0x40, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 3 },
+            { "cmp (zpg,x)", { 0x0200, 0x40, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xC1}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x40} } }, { 0x0202, 0x40, 0x02, 0x00, 0xFD, P0 | Z | C, {} }, 6 },
+            { "cmp (zpg),y", { 0x0200, 0x40, 0x00, 0x04, 0xFD, P0, { {0x0200, 0xD1}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12}, {0x1234, 0x40} } }, { 0x0202, 0x40, 0x00, 0x04, 0xFD, P0 | Z | C, {} }, 5 },
+            { "cmp zpg,x", { 0x0200, 0x40, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xD5}, {0x0201, 0x0E}, {0x0010, 0x40} } }, { 0x0202, 0x40, 0x02, 0x00, 0xFD, P0 | Z | C, {} }, 4 },
+            { "cmp abs,x (page crossed)", { 0x0200, 0x40, 0x44, 0x00, 0xFD, P0, { {0x0200, 0xDD}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x40} } }, { 0x0203, 0x40, 0x44, 0x00, 0xFD, P0 | Z | C, {} }, 5 },
+            { "cmp abs,y", { 0x0200, 0x40, 0x00, 0x04, 0xFD, P0, { {0x0200, 0xD9}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x40} } }, { 0x0203, 0x40, 0x00, 0x04, 0xFD, P0 | Z | C, {} }, 4 },
+            { "cmp (zpg)", { 0x0200, 0x40, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xD2}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x40} } }, { 0x0202, 0x40, 0x00, 0x00, 0xFD, P0 | Z | C, {} }, 5 },
+            { "cpx #", { 0x0200, 0x00, 0x10, 0x00, 0xFD, P0, { {0x0200, 0xE0}, {0x0201, 0x20} } }, { 0x0202, 0x00, 0x10, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "cpx abs", { 0x0200, 0x00, 0x10, 0x00, 0xFD, P0, { {0x0200, 0xEC}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x10} } }, { 0x0203, 0x00, 0x10, 0x00, 0xFD, P0 | Z | C, {} }, 4 },
+            { "cpx zpg", { 0x0200, 0x00, 0x10, 0x00, 0xFD, P0, { {0x0200, 0xE4}, {0x0201, 0x10}, {0x0010, 0x01} } }, { 0x0202, 0x00, 0x10, 0x00, 0xFD, P0 | C, {} }, 3 },
+            { "cpy #", { 0x0200, 0x00, 0x00, 0x20, 0xFD, P0, { {0x0200, 0xC0}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x20, 0xFD, P0 | C, {} }, 2 },
+            { "cpy abs", { 0x0200, 0x00, 0x00, 0x20, 0xFD, P0, { {0x0200, 0xCC}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x20} } }, { 0x0203, 0x00, 0x00, 0x20, 0xFD, P0 | Z | C, {} }, 4 },
+            { "cpy zpg", { 0x0200, 0x00, 0x00, 0x20, 0xFD, P0, { {0x0200, 0xC4}, {0x0201, 0x10}, {0x0010, 0xA0} } }, { 0x0202, 0x00, 0x00, 0x20, 0xFD, P0 | N, {} }, 3 },
+
+            // DEC, DEX, DEY
+            { "dec abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xCE}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x01} } }, { 0x0203, 0x00, 0x00, 0x00, 0xFD, P0 | Z, { {0x1234, 0x00} } }, 6 },
+            { "dec zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xC6}, {0x0201, 0x10}, {0x0010, 0x00} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0010, 0xFF} } }, 5 },
+            { "dec a", { 0x0200, 0x01, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x3A} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "dec zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xD6}, {0x0201, 0x0E}, {0x0010, 0x05} } }, { 0x0202, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0010, 0x04} } }, 6 },
+            { "dec abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0, { {0x0200, 0xDE}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x00, 0x04, 0x00, 0xFD, P0, { {0x1234, 0x04} } }, 7 },
+            { "dec abs,x (page crossed)", { 0x0200, 0x00, 0x44, 0x00, 0xFD, P0, { {0x0200, 0xDE}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x05} } }, { 0x0203, 0x00, 0x44, 0x00, 0xFD, P0, { {0x1334, 0x04} } }, 7 },
+            { "dex", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xCA} } }, { 0x0201, 0x00, 0xFF, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "dey", { 0x0200, 0x00, 0x00, 0x01, 0xFD, P0, { {0x0200, 0x88} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+
+            // INC, INX, INY
+            { "inc abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xEE}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0xFF} } }, { 0x0203, 0x00, 0x00, 0x00, 0xFD, P0 | Z, { {0x1234, 0x00} } }, 6 },
+            { "inc zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xE6}, {0x0201, 0x10}, {0x0010, 0x7F} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | N, { {0x0010, 0x80} } }, 5 },
+            { "inc a", { 0x0200, 0x41, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x1A} } }, { 0x0201, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "inc zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xF6}, {0x0201, 0x0E}, {0x0010, 0x05} } }, { 0x0202, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0010, 0x06} } }, 6 },
+            { "inc abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0, { {0x0200, 0xFE}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x05} } }, { 0x0203, 0x00, 0x04, 0x00, 0xFD, P0, { {0x1234, 0x06} } }, 7 },
+            { "inx", { 0x0200, 0x00, 0xFF, 0x00, 0xFD, P0, { {0x0200, 0xE8} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "iny", { 0x0200, 0x00, 0x00, 0x7F, 0xFD, P0, { {0x0200, 0xC8} } }, { 0x0201, 0x00, 0x00, 0x80, 0xFD, P0 | N, {} }, 2 },
+
+            // JMP, JSR, RTS, RTI, BRK
+            { "jmp abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x4C}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x1234, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "jmp (abs)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x6C}, {0x0201, 0x00}, {0x0202, 0x30}, {0x3000, 0x34}, {0x3001, 0x12} } }, { 0x1234, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 6 },
+            { "jmp (abs,x)", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x7C}, {0x0201, 0x00}, {0x0202, 0x30}, {0x3002, 0x34}, {0x3003, 0x12} } }, { 0x1234, 0x00, 0x02, 0x00, 0xFD, P0, {} }, 6 },
+            { "jsr", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x20}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x1234, 0x00, 0x00, 0x00, 0xFB, P0, { {0x01FD, 0x02}, {0x01FC, 0x02} } }, 6 },
+            { "rts", { 0x0200, 0x00, 0x00, 0x00, 0xFB, P0 | N | Z, { {0x0200, 0x60}, {0x01FC, 0x02}, {0x01FD, 0x12} } }, { 0x1203, 0x00, 0x00, 0x00, 0xFD, P0 | N | Z, {} }, 6 },
+            { "rti", { 0x0200, 0x00, 0x00, 0x00, 0xFA, P0, { {0x0200, 0x40}, {0x01FB, 0xC3}, {0x01FC, 0x34}, {0x01FD, 0x12} } }, { 0x1234, 0x00, 0x00, 0x00, 0xFD, P0 | N | V | Z | C, {} }, 6 },
+            { "brk", { 0x0200, 0x00, 0x00, 0x00, 0xFD, D | C, { {0x0200, 0x00}, {0xFFFE, 0x00}, {0xFFFF, 0x30} } }, { 0x3000, 0x00, 0x00, 0x00, 0xFA, P0 | I | C, { {0x01FD, 0x02}, {0x01FC, 0x02}, {0x01FB, B | U | D | C} } }, 7 },
+
+            // LDA
+            { "lda #", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA9}, {0x0201, 0x42} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "lda # (zero)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA9}, {0x0201, 0x00} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "lda # (negative)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA9}, {0x0201, 0x80} } }, { 0x0202, 0x80, 0x00, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "lda abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xAD}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+            { "lda zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA5}, {0x0201, 0x10}, {0x0010, 0x42} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "lda (zpg,x)", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xA1}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x42} } }, { 0x0202, 0x42, 0x02, 0x00, 0xFD, P0, {} }, 6 },
+            { "lda (zpg,x) (wraps)", { 0x0200, 0x00, 0x20, 0x00, 0xFD, P0, { {0x0200, 0xA1}, {0x0201, 0xF0}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x42} } }, { 0x0202, 0x42, 0x20, 0x00, 0xFD, P0, {} }, 6 },
+            { "lda (zpg),y", { 0x0200, 0x00, 0x00, 0x04, 0xFD, P0, { {0x0200, 0xB1}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12}, {0x1234, 0x42} } }, { 0x0202, 0x42, 0x00, 0x04, 0xFD, P0, {} }, 5 },
+            { "lda (zpg),y (page crossed)", { 0x0200, 0x00, 0x00, 0x44, 0xFD, P0, { {0x0200, 0xB1}, {0x0201, 0x10}, {0x0010, 0xF0}, {0x0011, 0x12}, {0x1334, 0x42} } }, { 0x0202, 0x42, 0x00, 0x44, 0xFD, P0, {} }, 6 },
+            { "lda zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xB5}, {0x0201, 0x0E}, {0x0010, 0x42} } }, { 0x0202, 0x42, 0x02, 0x00, 0xFD, P0, {} }, 4 },
+            { "lda abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0, { {0x0200, 0xBD}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x42, 0x04, 0x00, 0xFD, P0, {} }, 4 },
+            { "lda abs,x (page crossed)", { 0x0200, 0x00, 0x44, 0x00, 0xFD, P0, { {0x0200, 0xBD}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x42} } }, { 0x0203, 0x42, 0x44, 0x00, 0xFD, P0, {} }, 5 },
+            { "lda abs,y", { 0x0200, 0x00, 0x00, 0x04, 0xFD, P0, { {0x0200, 0xB9}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x42, 0x00, 0x04, 0xFD, P0, {} }, 4 },
+            { "lda abs,y (page crossed)", { 0x0200, 0x00, 0x00, 0x44, 0xFD, P0, { {0x0200, 0xB9}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x42} } }, { 0x0203, 0x42, 0x00, 0x44, 0xFD, P0, {} }, 5 },
+            { "lda (zpg)", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xB2}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12}, {0x1234, 0x42} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 5 },
+
+            // LDX, LDY
+            { "ldx #", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA2}, {0x0201, 0x80} } }, { 0x0202, 0x00, 0x80, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "ldx abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xAE}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x42, 0x00, 0xFD, P0, {} }, 4 },
+            { "ldx zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA6}, {0x0201, 0x10}, {0x0010, 0x00} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 3 },
+            { "ldx abs,y", { 0x0200, 0x00, 0x00, 0x04, 0xFD, P0, { {0x0200, 0xBE}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x42, 0x04, 0xFD, P0, {} }, 4 },
+            { "ldx abs,y (page crossed)", { 0x0200, 0x00, 0x00, 0x44, 0xFD, P0, { {0x0200, 0xBE}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x42} } }, { 0x0203, 0x00, 0x42, 0x44, 0xFD, P0, {} }, 5 },
+            { "ldx zpg,y", { 0x0200, 0x00, 0x00, 0x02, 0xFD, P0, { {0x0200, 0xB6}, {0x0201, 0x0E}, {0x0010, 0x42} } }, { 0x0202, 0x00, 0x42, 0x02, 0xFD, P0, {} }, 4 },
+            { "ldy #", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA0}, {0x0201, 0x80} } }, { 0x0202, 0x00, 0x00, 0x80, 0xFD, P0 | N, {} }, 2 },
+            { "ldy abs", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xAC}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x00, 0x42, 0xFD, P0, {} }, 4 },
+            { "ldy zpg", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xA4}, {0x0201, 0x10}, {0x0010, 0x00} } }, { 0x0202, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 3 },
+            { "ldy zpg,x", { 0x0200, 0x00, 0x02, 0x00, 0xFD, P0, { {0x0200, 0xB4}, {0x0201, 0x0E}, {0x0010, 0x42} } }, { 0x0202, 0x00, 0x02, 0x42, 0xFD, P0, {} }, 4 },
+            { "ldy abs,x", { 0x0200, 0x00, 0x04, 0x00, 0xFD, P0, { {0x0200, 0xBC}, {0x0201, 0x30}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x00, 0x04, 0x42, 0xFD, P0, {} }, 4 },
+            { "ldy abs,x (page crossed)", { 0x0200, 0x00, 0x44, 0x00, 0xFD, P0, { {0x0200, 0xBC}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x42} } }, { 0x0203, 0x00, 0x44, 0x42, 0xFD, P0, {} }, 5 },
+
+            // NOP
+            { "nop", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xEA} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+
+            // WAI and STP: the cycles up to the point the cpu sleeps
+            { "wai", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xCB} } }, { 0x0201, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "stp", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xDB} } }, { 0x0201, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+
+            // Stack
+            { "pha", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x48} } }, { 0x0201, 0x42, 0x00, 0x00, 0xFC, P0, { {0x01FD, 0x42} } }, 3 },
+            { "php", { 0x0200, 0x00, 0x00, 0x00, 0xFD, N | C, { {0x0200, 0x08} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFC, N | C, { {0x01FD, N | B | U | C} } }, 3 },
+            { "phx", { 0x0200, 0x00, 0x42, 0x00, 0xFD, P0, { {0x0200, 0xDA} } }, { 0x0201, 0x00, 0x42, 0x00, 0xFC, P0, { {0x01FD, 0x42} } }, 3 },
+            { "phy", { 0x0200, 0x00, 0x00, 0x42, 0xFD, P0, { {0x0200, 0x5A} } }, { 0x0201, 0x00, 0x00, 0x42, 0xFC, P0, { {0x01FD, 0x42} } }, 3 },
+            { "pla", { 0x0200, 0x00, 0x00, 0x00, 0xFC, P0, { {0x0200, 0x68}, {0x01FD, 0x80} } }, { 0x0201, 0x80, 0x00, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "pla (zero)", { 0x0200, 0x42, 0x00, 0x00, 0xFC, P0, { {0x0200, 0x68}, {0x01FD, 0x00} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 4 },
+            { "plp", { 0x0200, 0x00, 0x00, 0x00, 0xFC, P0, { {0x0200, 0x28}, {0x01FD, N | V | D | C} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, N | V | D | C, {} }, 4 },
+            { "plx", { 0x0200, 0x00, 0x00, 0x00, 0xFC, P0, { {0x0200, 0xFA}, {0x01FD, 0x80} } }, { 0x0201, 0x00, 0x80, 0x00, 0xFD, P0 | N, {} }, 4 },
+            { "ply", { 0x0200, 0x00, 0x00, 0x42, 0xFC, P0, { {0x0200, 0x7A}, {0x01FD, 0x00} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 4 },
+
+            // STA, STX, STY
+            { "sta zpg", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x85}, {0x0201, 0x10} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0010, 0x42} } }, 3 },
+            { "sta zpg,x", { 0x0200, 0x42, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x95}, {0x0201, 0x0E} } }, { 0x0202, 0x42, 0x02, 0x00, 0xFD, P0, { {0x0010, 0x42} } }, 4 },
+            { "sta abs", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x8D}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 4 },
+            { "sta abs,x", { 0x0200, 0x42, 0x04, 0x00, 0xFD, P0, { {0x0200, 0x9D}, {0x0201, 0x30}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x04, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 5 },
+            { "sta abs,x (page crossed)", { 0x0200, 0x42, 0x44, 0x00, 0xFD, P0, { {0x0200, 0x9D}, {0x0201, 0xF0}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x44, 0x00, 0xFD, P0, { {0x1334, 0x42} } }, 5 },
+            { "sta abs,y", { 0x0200, 0x42, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x99}, {0x0201, 0x30}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x00, 0x04, 0xFD, P0, { {0x1234, 0x42} } }, 5 },
+            { "sta abs,y (page crossed)", { 0x0200, 0x42, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x99}, {0x0201, 0xF0}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x00, 0x44, 0xFD, P0, { {0x1334, 0x42} } }, 5 },
+            { "sta (zpg,x)", { 0x0200, 0x42, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x81}, {0x0201, 0x0E}, {0x0010, 0x34}, {0x0011, 0x12} } }, { 0x0202, 0x42, 0x02, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 6 },
+            { "sta (zpg),y", { 0x0200, 0x42, 0x00, 0x04, 0xFD, P0, { {0x0200, 0x91}, {0x0201, 0x10}, {0x0010, 0x30}, {0x0011, 0x12} } }, { 0x0202, 0x42, 0x00, 0x04, 0xFD, P0, { {0x1234, 0x42} } }, 6 },
+            { "sta (zpg),y (page crossed)", { 0x0200, 0x42, 0x00, 0x44, 0xFD, P0, { {0x0200, 0x91}, {0x0201, 0x10}, {0x0010, 0xF0}, {0x0011, 0x12} } }, { 0x0202, 0x42, 0x00, 0x44, 0xFD, P0, { {0x1334, 0x42} } }, 6 },
+            { "sta (zpg)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x92}, {0x0201, 0x10}, {0x0010, 0x34}, {0x0011, 0x12} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 5 },
+            { "stx zpg", { 0x0200, 0x00, 0x42, 0x00, 0xFD, P0, { {0x0200, 0x86}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x42, 0x00, 0xFD, P0, { {0x0010, 0x42} } }, 3 },
+            { "stx zpg,y", { 0x0200, 0x00, 0x42, 0x02, 0xFD, P0, { {0x0200, 0x96}, {0x0201, 0x0E} } }, { 0x0202, 0x00, 0x42, 0x02, 0xFD, P0, { {0x0010, 0x42} } }, 4 },
+            { "stx abs", { 0x0200, 0x00, 0x42, 0x00, 0xFD, P0, { {0x0200, 0x8E}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x0203, 0x00, 0x42, 0x00, 0xFD, P0, { {0x1234, 0x42} } }, 4 },
+            { "sty zpg", { 0x0200, 0x00, 0x00, 0x42, 0xFD, P0, { {0x0200, 0x84}, {0x0201, 0x10} } }, { 0x0202, 0x00, 0x00, 0x42, 0xFD, P0, { {0x0010, 0x42} } }, 3 },
+            { "sty zpg,x", { 0x0200, 0x00, 0x02, 0x42, 0xFD, P0, { {0x0200, 0x94}, {0x0201, 0x0E} } }, { 0x0202, 0x00, 0x02, 0x42, 0xFD, P0, { {0x0010, 0x42} } }, 4 },
+            { "sty abs", { 0x0200, 0x00, 0x00, 0x42, 0xFD, P0, { {0x0200, 0x8C}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x0203, 0x00, 0x00, 0x42, 0xFD, P0, { {0x1234, 0x42} } }, 4 },
+            { "stz zpg", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x64}, {0x0201, 0x10}, {0x0010, 0x42} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0010, 0x00} } }, 3 },
+            { "stz zpg,x", { 0x0200, 0x42, 0x02, 0x00, 0xFD, P0, { {0x0200, 0x74}, {0x0201, 0x0E}, {0x0010, 0x42} } }, { 0x0202, 0x42, 0x02, 0x00, 0xFD, P0, { {0x0010, 0x00} } }, 4 },
+            { "stz abs", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x9C}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x42} } }, { 0x0203, 0x42, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x00} } }, 4 },
+            { "stz abs,x (page crossed)", { 0x0200, 0x42, 0x44, 0x00, 0xFD, P0, { {0x0200, 0x9E}, {0x0201, 0xF0}, {0x0202, 0x12}, {0x1334, 0x42} } }, { 0x0203, 0x42, 0x44, 0x00, 0xFD, P0, { {0x1334, 0x00} } }, 5 },
+
+            // TSB, TRB
+            { "tsb zpg", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x04}, {0x0201, 0x10}, {0x0010, 0x30} } }, { 0x0202, 0x0F, 0x00, 0x00, 0xFD, P0 | Z, { {0x0010, 0x3F} } }, 5 },
+            { "tsb abs", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0 | Z, { {0x0200, 0x0C}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0x31} } }, { 0x0203, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x1234, 0x3F} } }, 6 },
+            { "trb zpg", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x14}, {0x0201, 0x10}, {0x0010, 0x33} } }, { 0x0202, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0010, 0x30} } }, 5 },
+            { "trb abs", { 0x0200, 0x0F, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x1C}, {0x0201, 0x34}, {0x0202, 0x12}, {0x1234, 0xF0} } }, { 0x0203, 0x0F, 0x00, 0x00, 0xFD, P0 | Z, { {0x1234, 0xF0} } }, 6 },
+
+            // Transfers
+            { "tax", { 0x0200, 0x80, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xAA} } }, { 0x0201, 0x80, 0x80, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "tax (zero)", { 0x0200, 0x00, 0x42, 0x00, 0xFD, P0, { {0x0200, 0xAA} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "txa (zero)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x8A} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "tay (zero)", { 0x0200, 0x00, 0x00, 0x42, 0xFD, P0, { {0x0200, 0xA8} } }, { 0x0201, 0x00, 0x00, 0x00, 0xFD, P0 | Z, {} }, 2 },
+            { "tya", { 0x0200, 0x00, 0x00, 0x80, 0xFD, P0 | Z, { {0x0200, 0x98} } }, { 0x0201, 0x80, 0x00, 0x80, 0xFD, P0 | N, {} }, 2 },
+            { "tsx", { 0x0200, 0x00, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xBA} } }, { 0x0201, 0x00, 0xFD, 0x00, 0xFD, P0 | N, {} }, 2 },
+            { "txs", { 0x0200, 0x00, 0x80, 0x00, 0xFD, P0 | Z, { {0x0200, 0x9A} } }, { 0x0201, 0x00, 0x80, 0x00, 0x80, P0 | Z, {} }, 2 },
+
+            // The opcodes without an instruction are NOPs of one to three bytes on the 65C02
+            { "nop (x3)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x03} } }, { 0x0201, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 1 },
+            { "nop (xF)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xFF} } }, { 0x0201, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 1 },
+            { "nop #", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x02}, {0x0201, 0x10} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 2 },
+            { "nop zpg", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x44}, {0x0201, 0x10} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 3 },
+            { "nop zpg,x", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xF4}, {0x0201, 0x10} } }, { 0x0202, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+            { "nop abs (5C)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0x5C}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 8 },
+            { "nop abs (DC)", { 0x0200, 0x42, 0x00, 0x00, 0xFD, P0, { {0x0200, 0xDC}, {0x0201, 0x34}, {0x0202, 0x12} } }, { 0x0203, 0x42, 0x00, 0x00, 0xFD, P0, {} }, 4 },
+        };
+    }
+
+    auto opcode_vectors() -> const std::vector<opcode_vector>&
+    {
+        return vectors;
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef __OPCODEVECTORSH
+#define __OPCODEVECTORSH
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../xerxes_lib/common.h"
+
+namespace dave
+{
+    // The registers, and the bytes of memory that matter
+    struct cpu_state {
+        REG16 PC;
+        REG8 A;
+        REG8 X;
+        REG8 Y;
+        REG8 S;
+        REG8 P;
+        std::vector<std::pair<REG16, REG8>> memory;
+    };
+
+    // One instruction: the state before it (memory holds the instruction, and what it reads), the state after it
+    // (memory holds every byte it writes) and the cycles it takes on a 65C02. B and the unused bit of P don't exist
+    // in the register, and aren't compared.
+    struct opcode_vector {
+        std::string name;
+        cpu_state before;
+        cpu_state after;
+        size_t cycles;
+    };
+
+    auto opcode_vectors() -> const std::vector<opcode_vector>&;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "step_debugger.h"
+
+namespace dave
+{
+
+void step_debugger::attach_system_bus(system_bus *bus)
+{}
+
+bool step_debugger::break_on_started()
+{
+    return false;
+}
+
+bool step_debugger::break_on_next_instruction_ready(const REG16 &next_instruction_addr)
+{
+    // The first time for the instruction we step, the second time for the one after it
+    if (_started) {
+        return true;
+    }
+    _started = true;
+    return false;
+}
+
+bool step_debugger::break_after_instruction()
+{
+    return false;
+}
+
+bool step_debugger::break_on_reset()
+{
+    return false;
+}
+
+bool step_debugger::break_on_nmi()
+{
+    return false;
+}
+
+bool step_debugger::break_on_interupt()
+{
+    return false;
+}
+
+bool step_debugger::break_on_break()
+{
+    return false;
+}
+
+bool step_debugger::break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode)
+{
+    return false;
+}
+
+bool step_debugger::break_on_stop(const REG16 &addr)
+{
+    return false;
+}
+
+bool step_debugger::break_asap()
+{
+    return false;
+}
+
+bool step_debugger::break_on_bus_address_changed(const REG16 &addr)
+{
+    return false;
+}
+
+void step_debugger::report_cpu_register(const std::string &name, const uint8_t &value)
+{}
+
+void step_debugger::report_cpu_register(const std::string &name, const uint16_t &value)
+{}
+
+void step_debugger::report_cpu_register(const std::string &name, const bool &value)
+{}
+
+void step_debugger::tick()
+{}
+
+void step_debugger::report_address_write(const REG16 &addr, const REG8 *data)
+{
+    _writes.push_back(std::make_pair(addr, *data));
+}
+
+void step_debugger::report_nmi_line(bool value)
+{}
+
+void step_debugger::report_irq_line(bool value)
+{}
+
+void step_debugger::report_reset_line(bool value)
+{}
+
+void step_debugger::report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer)
+{}
+
+}
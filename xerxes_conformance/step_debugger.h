@@ -0,0 +1,51 @@
+#ifndef __STEP_DEBUGGERH
+#define __STEP_DEBUGGERH
+
+#include <utility>
+#include <vector>
+#include "../xerxes_lib/debugger.h"
+
+namespace dave
+{
+    // Debugger that steps a cpu one instruction at a time. After start() the cpu runs the next instruction, and breaks
+    // once it is ready for the one after it. Records the bus writes of the instruction.
+    class step_debugger : public debugger {
+    private:
+        bool _started = false;
+    public:
+        std::vector<std::pair<REG16, REG8>> _writes;
+
+        void start() {
+            _started = false;
+            _writes.clear();
+        }
+
+        virtual void attach_system_bus(system_bus *bus) override;
+
+        virtual bool break_on_started() override;
+        virtual bool break_on_next_instruction_ready(const REG16 &next_instruction_addr) override;
+        virtual bool break_after_instruction() override;
+        virtual bool break_on_reset() override;
+        virtual bool break_on_nmi() override;
+        virtual bool break_on_interupt() override;
+        virtual bool break_on_break() override;
+        virtual bool break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode) override;
+        virtual bool break_on_stop(const REG16 &addr) override;
+        virtual bool break_asap() override;
+        virtual bool break_on_bus_address_changed(const REG16 &addr) override;
+
+        virtual void report_cpu_register(const std::string &name, const uint8_t &value) override;
+        virtual void report_cpu_register(const std::string &name, const uint16_t &value) override;
+        virtual void report_cpu_register(const std::string &name, const bool &value) override;
+        virtual void tick() override;
+        virtual void report_address_write(const REG16 &addr, const REG8 *data) override;
+
+        virtual void report_nmi_line(bool value) override;
+        virtual void report_irq_line(bool value) override;
+        virtual void report_reset_line(bool value) override;
+
+        virtual void report_punchcardreader_status(bool irqHigh, bool nextByteRequested, REG8 status, REG8 byteInBuffer) override;
+    };
+}
+
+#endif
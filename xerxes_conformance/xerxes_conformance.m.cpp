@@ -0,0 +1,303 @@
+#include "../xerxes_lib/system_bus.h"
+#include "../xerxes_lib/cpu6502.h"
+#include "../xerxes_lib/ram.h"
+#include "../xerxes_lib/work_pool.h"
+#include "step_debugger.h"
+#include "opcode_vectors.h"
+#include "cores.h"
+#include "fuzzer.h"
+#include "multi_cpu.h"
+#include "devices.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// B and the unused bit don't exist in the status register
+const dave::REG8 status_mask = 0xCF;
+
+std::string hex(unsigned int value, int width)
+{
+    std::ostringstream stm;
+    stm << std::hex << std::uppercase << std::setfill('0') << std::setw(width) << value;
+    return stm.str();
+}
+
+// Run the vector's instruction on a fresh cpu, and describe every way it differs from the vector (nothing if it conforms)
+std::string run_vector(const dave::core &c, const dave::opcode_vector &v)
+{
+    bool irq = false, nmi = false;
+    dave::step_debugger debugger;
+    dave::system_bus bus(&debugger, irq, nmi);
+    bus.attach_device(std::make_unique<dave::ram<0x0000, 0xFFFF>>(&bus, &debugger));
+    for(auto &m : v.before.memory) {
+        bus.direct(m.first >> 8)[m.first & 0xFF] = m.second;
+    }
+
+    auto cpu = c.create(&bus, &debugger);
+    auto &regs = cpu->_registers;
+    regs.PC = v.before.PC;
+    regs.A = v.before.A;
+    regs.X = v.before.X;
+    regs.Y = v.before.Y;
+    regs.S = v.before.S;
+    *((dave::REG8*)&regs.P) = v.before.P;
+
+    auto cycles = dave::step_instruction(cpu.get(), debugger, false);
+
+    std::ostringstream stm;
+    auto check = [&stm](const char *name, unsigned int value, unsigned int expected, int width) {
+        if (value != expected) {
+            stm << " " << name << "=" << hex(value, width) << " (" << hex(expected, width) << ")";
+        }
+    };
+    check("PC", regs.PC, v.after.PC, 4);
+    check("A", regs.A, v.after.A, 2);
+    check("X", regs.X, v.after.X, 2);
+    check("Y", regs.Y, v.after.Y, 2);
+    check("S", regs.S, v.after.S, 2);
+    check("P", *((dave::REG8*)&regs.P) & status_mask, v.after.P & status_mask, 2);
+    std::set<dave::REG16> expected_writes;
+    for(auto &m : v.after.memory) {
+        expected_writes.insert(m.first);
+        check(("[" + hex(m.first, 4) + "]").c_str(), bus.direct(m.first >> 8)[m.first & 0xFF], m.second, 2);
+    }
+    for(auto &w : debugger._writes) {
+        if (expected_writes.count(w.first) == 0) {
+            stm << " write [" << hex(w.first, 4) << "]=" << hex(w.second, 2);
+        }
+    }
+    if (cycles != v.cycles) {
+        stm << " cycles=" << cycles << " (" << v.cycles << ")";
+    }
+    return stm.str();
+}
+
+int check_vectors(const std::string &core_name, bool only_op, dave::REG8 op, bool verbose)
+{
+    auto &vectors = dave::opcode_vectors();
+    auto started = std::chrono::steady_clock::now();
+    size_t run = 0, failed = 0;
+    std::set<dave::REG8> opcodes;
+    for(auto &c : dave::cpu_cores()) {
+        if (!core_name.empty() && c.name != core_name) continue;
+        for(auto &v : vectors) {
+            // The opcode is the byte at the PC
+            dave::REG8 opcode = 0;
+            for(auto &m : v.before.memory) {
+                if (m.first == v.before.PC) opcode = m.second;
+            }
+            if (only_op && opcode != op) continue;
+            opcodes.insert(opcode);
+            run++;
+            auto diff = run_vector(c, v);
+            if (!diff.empty()) {
+                failed++;
+                std::cout << "FAIL " << c.name << " " << hex(opcode, 2) << " " << v.name << ":" << diff << std::endl;
+            }
+            else if (verbose) {
+                std::cout << "ok   " << c.name << " " << hex(opcode, 2) << " " << v.name << std::endl;
+            }
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started);
+    if (run == 0) {
+        std::cerr << "No vectors to run" << std::endl;
+        return 1;
+    }
+
+    std::cout << run << " vectors (" << opcodes.size() << " opcodes), " << failed << " failed, in " << elapsed.count() / 1000.0 << " ms" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+// Fuzz the candidate against the reference, with the seeds seed..seed+sequences-1 spread over the host threads
+int fuzz(const dave::core &reference, const dave::core &candidate, size_t sequences, size_t length, uint64_t seed, size_t threads)
+{
+    // Every task runs a block of seeds; once a sequence differs, the blocks after it are skipped
+    const size_t block = 256;
+    std::atomic<uint64_t> first_failed(seed + sequences);
+    std::mutex lock;
+    dave::fuzz_result failure;
+    std::atomic<size_t> instructions(0);
+    std::vector<std::function<void()> > tasks;
+    for(uint64_t from = seed; from < seed + sequences; from += block) {
+        auto to = std::min(from + block, seed + sequences);
+        tasks.push_back([&, from, to]() {
+            dave::fuzzer f(reference, candidate);
+            size_t run = 0;
+            for(auto s = from; s < to && s < first_failed.load(std::memory_order_relaxed); s++) {
+                auto r = f.run(s, length);
+                run += r.instructions;
+                if (!r.difference.empty()) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (s < first_failed) {
+                        first_failed = s;
+                        failure = r;
+                    }
+                    break;
+                }
+            }
+            instructions += run;
+        });
+    }
+
+    dave::work_pool pool(threads);
+    auto started = std::chrono::steady_clock::now();
+    pool.run(std::move(tasks));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+
+    std::cout << candidate.name << " against " << reference.name << ": " << instructions << " instructions on " << pool.threads() << " threads in " << elapsed.count() << " ms" << std::endl;
+    if (first_failed != seed + sequences) {
+        std::cout << "DIFF seed " << first_failed << ", instruction " << failure.instructions << ": " << failure.difference << " (reference in brackets)" << std::endl;
+        return 1;
+    }
+    std::cout << sequences << " sequences of " << length << " instructions agree" << std::endl;
+    return 0;
+}
+
+int check_multi_cpu()
+{
+    auto difference = dave::check_rounds(1000);
+    if (!difference.empty()) {
+        std::cout << "FAIL rounds: " << difference << " (expected in brackets)" << std::endl;
+        return 1;
+    }
+    std::cout << "ok   rounds: 2 cpu's, budgets 1 and 3, quantum 5" << std::endl;
+    difference = dave::check_parallel(1000);
+    if (!difference.empty()) {
+        std::cout << "FAIL parallel: " << difference << " (serial in brackets)" << std::endl;
+        return 1;
+    }
+    std::cout << "ok   parallel: 2 cpu's, the same as serially" << std::endl;
+    return 0;
+}
+
+int check_devices()
+{
+    const std::pair<const char*, std::function<std::string()> > checks[] = {
+        { "banked ram", dave::check_banked_ram },
+        { "dma controller", dave::check_dma_controller },
+        { "interval timer", dave::check_interval_timer },
+    };
+    int failed = 0;
+    for(auto &c : checks) {
+        auto difference = c.second();
+        if (difference.empty()) {
+            std::cout << "ok   " << c.first << std::endl;
+        }
+        else {
+            std::cout << "FAIL " << c.first << ": " << difference << " (expected in brackets)" << std::endl;
+            failed = 1;
+        }
+    }
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 2 && std::string(argv[1]) == "--help") {
+        std::cout << "xerxes_conformance [options]" << std::endl;
+        std::cout << " -core   : the cpu core to check (all of them if not specified), or the reference to fuzz against" << std::endl;
+        std::cout << " -op     : only check the vectors for this opcode (hex)" << std::endl;
+        std::cout << " -v      : list every vector, not only the ones that fail" << std::endl;
+        std::cout << " -fuzz   : fuzz this many random sequences, instead of checking the vectors" << std::endl;
+        std::cout << " -against: the core to fuzz against the reference (the reference itself if not specified)" << std::endl;
+        std::cout << " -length : instructions per sequence (100 if not specified)" << std::endl;
+        std::cout << " -seed   : seed of the first sequence (1 if not specified)" << std::endl;
+        std::cout << " -threads: number of host threads to fuzz on (one per core if not specified)" << std::endl;
+        std::cout << " -multi  : check how the cpu's of a multi-cpu bus run their rounds, instead of the vectors" << std::endl;
+        std::cout << " -devices: check the devices against what their registers promise, instead of the vectors" << std::endl;
+        std::cout << "Runs every opcode vector on the cpu cores, and reports the registers, memory and cycles that differ as value (expected)." << std::endl;
+        std::cout << "Fuzzing runs the reference through tick() and the other core through run(), from random memory and" << std::endl;
+        std::cout << "registers, and stops at the first instruction after which the registers, bus writes or cycles differ." << std::endl;
+        return 0;
+    }
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::string core_name;
+    std::string against;
+    bool only_op = false;
+    dave::REG8 op = 0;
+    bool verbose = false;
+    size_t sequences = 0;
+    size_t length = 100;
+    uint64_t seed = 1;
+    size_t threads = 0;
+    bool multi = false;
+    bool devices = false;
+    size_t i = 0;
+    while(i < args.size()) {
+        if (args[i] == "-core" && i + 1 < args.size()) {
+            core_name = args[i + 1];
+            i += 2;
+        }
+        else if (args[i] == "-op" && i + 1 < args.size()) {
+            only_op = true;
+            op = (dave::REG8)strtoul(args[i + 1].c_str(), NULL, 16);
+            i += 2;
+        }
+        else if (args[i] == "-v") {
+            verbose = true;
+            i++;
+        }
+        else if (args[i] == "-fuzz" && i + 1 < args.size()) {
+            sequences = (size_t)strtoull(args[i + 1].c_str(), NULL, 10);
+            i += 2;
+        }
+        else if (args[i] == "-against" && i + 1 < args.size()) {
+            against = args[i + 1];
+            i += 2;
+        }
+        else if (args[i] == "-length" && i + 1 < args.size()) {
+            length = (size_t)strtoull(args[i + 1].c_str(), NULL, 10);
+            i += 2;
+        }
+        else if (args[i] == "-seed" && i + 1 < args.size()) {
+            seed = strtoull(args[i + 1].c_str(), NULL, 10);
+            i += 2;
+        }
+        else if (args[i] == "-threads" && i + 1 < args.size()) {
+            threads = (size_t)strtoul(args[i + 1].c_str(), NULL, 10);
+            i += 2;
+        }
+        else if (args[i] == "-multi") {
+            multi = true;
+            i++;
+        }
+        else if (args[i] == "-devices") {
+            devices = true;
+            i++;
+        }
+        else {
+            std::cerr << "Unexpected argument '" << args[i] << "'" << std::endl;
+            return 1;
+        }
+    }
+
+    if (multi) {
+        return check_multi_cpu();
+    }
+    if (devices) {
+        return check_devices();
+    }
+    if (sequences == 0) {
+        return check_vectors(core_name, only_op, op, verbose);
+    }
+
+    auto reference = core_name.empty() ? &dave::cpu_cores().front() : dave::find_core(core_name);
+    auto candidate = against.empty() ? reference : dave::find_core(against);
+    if (reference == nullptr || candidate == nullptr) {
+        std::cerr << "Unknown core '" << (reference == nullptr ? core_name : against) << "'" << std::endl;
+        return 1;
+    }
+    return fuzz(*reference, *candidate, sequences, length, seed, threads);
+}
@@ -0,0 +1,102 @@
+#ifndef __BANKED_RAMH
+#define __BANKED_RAMH
+
+#include <vector>
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+namespace dave
+{
+    // RAM between addr_lower and addr_upper, cut into windows of window_size bytes (4K or 8K). Every window maps
+    // onto a bank of a (much larger) host side pool, so switching a bank only swaps the window's pointer.
+    //   control_addr    : the window to switch (0 = the window at addr_lower)
+    //   control_addr + 1: bank of the selected window, low byte
+    //   control_addr + 2: bank of the selected window, high byte
+    // Writing either bank byte maps the bank straight away. At powerup window n maps onto bank n.
+    template<REG16 addr_lower, REG16 addr_upper, REG16 control_addr, REG16 window_size = 0x1000> class banked_ram : public device {
+        static_assert(window_size == 0x1000 || window_size == 0x2000, "Windows are 4K or 8K");
+        static_assert(addr_lower % window_size == 0 && (addr_upper + 1) % window_size == 0, "The RAM must be made up of whole windows");
+    private:
+        static const size_t windows = (addr_upper - addr_lower + 1) / window_size;
+
+        std::vector<REG8> _pool;
+        size_t _banks;
+        REG8 *_window[windows];
+        uint16_t _bank[windows];
+        REG8 _selected = 0;
+
+        void map(size_t window, uint16_t bank) {
+            _bank[window] = bank;
+            _window[window] = &_pool[(bank % _banks) * window_size];
+        }
+    public:
+        // banks is the size of the pool, in windows: 256 4K banks is 1MB
+        banked_ram(system_bus *bus, debugger *debugger, size_t banks = 256)
+            : device(bus, debugger), _pool((banks < windows ? windows : banks) * window_size), _banks(banks < windows ? windows : banks)
+        {
+            for(size_t i = 0; i < windows; i++) {
+                map(i, (uint16_t)i);
+            }
+        }
+        banked_ram() = delete;
+        banked_ram(const banked_ram&) = delete;
+        banked_ram(banked_ram &&) = delete;
+        auto operator =(const banked_ram&)->banked_ram& = delete;
+        auto operator =(banked_ram &&)->banked_ram& = delete;
+
+        auto banks() const -> size_t { return _banks; }
+        // Direct access to a bank of the pool, i.e. to load data from the host
+        auto bank(size_t bank) -> REG8* { return &_pool[(bank % _banks) * window_size]; }
+
+        virtual void powerup() override {
+            _selected = 0;
+            for(size_t i = 0; i < windows; i++) {
+                map(i, (uint16_t)i);
+            }
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            if (address >= addr_lower && address <= addr_upper) {
+                auto offset = address - addr_lower;
+                _window[offset / window_size][offset % window_size] = *data;
+            }
+            else if (address == control_addr) {
+                _selected = *data;
+            }
+            else if (address == control_addr + 1 && _selected < windows) {
+                map(_selected, (_bank[_selected] & 0xFF00) | *data);
+            }
+            else if (address == control_addr + 2 && _selected < windows) {
+                map(_selected, (_bank[_selected] & 0x00FF) | (*data << 8));
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            if (address >= addr_lower && address <= addr_upper) {
+                auto offset = address - addr_lower;
+                *dest = _window[offset / window_size][offset % window_size];
+            }
+            else if (address == control_addr) {
+                *dest = _selected;
+            }
+            else if (address == control_addr + 1 && _selected < windows) {
+                *dest = (REG8)(_bank[_selected] & 0xFF);
+            }
+            else if (address == control_addr + 2 && _selected < windows) {
+                *dest = (REG8)(_bank[_selected] >> 8);
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return (page >= (addr_lower >> 8) && page <= (addr_upper >> 8)) || page == (control_addr >> 8) || page == ((control_addr + 2) >> 8);
+        }
+        virtual REG8* direct(REG8 page) override {
+            // Pages inside a window, never the control page
+            if (page < (addr_lower >> 8) || page > (addr_upper >> 8) || page == (control_addr >> 8) || page == ((control_addr + 2) >> 8)) return nullptr;
+            auto offset = ((REG16)page << 8) - addr_lower;
+            return &_window[offset / window_size][offset % window_size];
+        }
+    };
+}
+
+#endif
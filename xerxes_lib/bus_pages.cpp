@@ -0,0 +1,29 @@
+#include "bus_pages.h"
+
+namespace dave
+{
+
+bus_pages::bus_pages()
+: _interrupted(false)
+{
+    begin_round();
+}
+
+void bus_pages::resize(size_t cpus)
+{
+    _active = std::make_unique<std::atomic<bool>[]>(cpus);
+    for(size_t i = 0; i < cpus; i++) {
+        _active[i].store(false);
+    }
+    _cpus = cpus;
+}
+
+void bus_pages::begin_round()
+{
+    for(auto &o : _owner) {
+        o.store(free, std::memory_order_relaxed);
+    }
+    _interrupted.store(false);
+}
+
+}
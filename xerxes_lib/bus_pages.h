@@ -0,0 +1,74 @@
+#ifndef __BUS_PAGESH
+#define __BUS_PAGESH
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common.h"
+
+namespace dave
+{
+    // Ownership of the 256 pages of the address space while cpus run in parallel. The first cpu to touch a page in
+    // a round owns it, and accesses its pages without synchronisation. When a cpu touches a page owned by another
+    // cpu, the page becomes shared and the round is interrupted: from then on every access is serialised, and the
+    // cpus stop at their next instruction.
+    class bus_pages {
+    private:
+        static const int free = -1;
+        static const int shared = -2;
+
+        std::atomic<int> _owner[256];
+        std::atomic<bool> _interrupted;
+        std::unique_ptr<std::atomic<bool>[]> _active; // per cpu: busy with an unsynchronised access
+        size_t _cpus = 0;
+        std::mutex _serial;
+    public:
+        bus_pages();
+
+        bus_pages(const bus_pages&) = delete;
+        bus_pages(bus_pages &&) = delete;
+        auto operator =(const bus_pages&)->bus_pages& = delete;
+        auto operator =(bus_pages &&)->bus_pages& = delete;
+
+        void resize(size_t cpus);
+
+        // Only call between rounds, when no cpu runs
+        void begin_round();
+
+        void interrupt() { _interrupted.store(true); }
+        auto interrupted() const -> bool { return _interrupted.load(std::memory_order_relaxed); }
+
+        template<typename F> void access(size_t cpu, const REG16 &address, F f) {
+            auto &owner = _owner[address >> 8];
+            int o = owner.load(std::memory_order_acquire);
+            if (o == free && owner.compare_exchange_strong(o, (int)cpu)) {
+                o = (int)cpu;
+            }
+            if (o == (int)cpu) {
+                _active[cpu].store(true);
+                if (!_interrupted.load()) {
+                    f();
+                    _active[cpu].store(false, std::memory_order_release);
+                    return;
+                }
+                _active[cpu].store(false);
+            }
+            else {
+                owner.store(shared, std::memory_order_relaxed);
+                _interrupted.store(true);
+            }
+            // Serialise with every other cpu, including the ones busy with an unsynchronised access
+            std::lock_guard<std::mutex> guard(_serial);
+            for(size_t i = 0; i < _cpus; i++) {
+                while(i != cpu && _active[i].load()) {
+                    std::this_thread::yield();
+                }
+            }
+            f();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "bus_profile.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace dave
+{
+
+namespace
+{
+    // The 'top' indices with the highest counts, highest first (the lower index first when they're equal)
+    std::vector<size_t> hottest(const std::vector<uint64_t> &counts, size_t top)
+    {
+        std::vector<size_t> order;
+        for(size_t i = 0; i < counts.size(); i++) {
+            if (counts[i] != 0) order.push_back(i);
+        }
+        auto n = std::min(top, order.size());
+        std::partial_sort(order.begin(), order.begin() + n, order.end(), [&counts](size_t a, size_t b) {
+            return counts[a] != counts[b] ? counts[a] > counts[b] : a < b;
+        });
+        order.resize(n);
+        return order;
+    }
+}
+
+void bus_profile::report(std::ostream &stm, size_t now, const std::vector<REG8> &io_pages, size_t top) const
+{
+    std::vector<uint64_t> page_fetches(256), page_reads(256), page_writes(256), pages(256);
+    uint64_t total_fetches = 0, total_reads = 0, total_writes = 0;
+    for(size_t a = 0; a < 0x10000; a++) {
+        page_fetches[a >> 8] += fetches[a];
+        page_reads[a >> 8] += reads[a];
+        page_writes[a >> 8] += writes[a];
+        total_fetches += fetches[a];
+        total_reads += reads[a];
+        total_writes += writes[a];
+    }
+    for(size_t p = 0; p < 256; p++) {
+        pages[p] = page_fetches[p] + page_reads[p] + page_writes[p];
+    }
+
+    stm << "cycles " << from_cycle << " to " << now << ": " << total_fetches << " fetches, " << total_reads
+        << " reads, " << total_writes << " writes" << std::endl;
+    stm << std::uppercase << std::setfill('0');
+
+    stm << std::endl << "hottest pages (fetches reads writes)" << std::endl;
+    for(auto p : hottest(pages, top)) {
+        stm << "  " << std::hex << std::setw(2) << p << std::dec << " " << page_fetches[p] << " " << page_reads[p]
+            << " " << page_writes[p] << std::endl;
+    }
+
+    // The operands and data the instructions read and write, the fetches are the code
+    std::vector<uint64_t> zero_page(256);
+    for(size_t a = 0; a < 256; a++) {
+        zero_page[a] = reads[a] + writes[a];
+    }
+    stm << std::endl << "hottest zero page addresses (reads writes)" << std::endl;
+    for(auto a : hottest(zero_page, top)) {
+        stm << "  " << std::hex << std::setw(4) << a << std::dec << " " << reads[a] << " " << writes[a] << std::endl;
+    }
+
+    std::vector<uint64_t> io(0x10000);
+    for(size_t p : io_pages) {
+        for(size_t a = p << 8; a < (p + 1) << 8; a++) {
+            io[a] = reads[a];
+        }
+    }
+    stm << std::endl << "most polled I/O registers (reads writes)" << std::endl;
+    for(auto a : hottest(io, top)) {
+        stm << "  " << std::hex << std::setw(4) << a << std::dec << " " << reads[a] << " " << writes[a] << std::endl;
+    }
+
+    // The stack grows down from 01FF, the lowest byte written is as deep as it went
+    size_t lowest = 0x200;
+    for(size_t a = 0x100; a < 0x200; a++) {
+        if (writes[a] != 0) {
+            lowest = a;
+            break;
+        }
+    }
+    stm << std::endl << "stack: " << 0x200 - lowest << " bytes deep";
+    if (lowest != 0x200) {
+        stm << " (down to " << std::hex << std::setw(4) << lowest << std::dec << ")";
+    }
+    stm << std::endl;
+}
+
+}
@@ -0,0 +1,37 @@
+#ifndef __BUS_PROFILEH
+#define __BUS_PROFILEH
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "common.h"
+
+namespace dave
+{
+    // The bus accesses per address, split in the cpu's opcode fetches, its other reads (operands and data) and the
+    // writes. The counters are flat arrays of the 64K addresses, so counting an access is an increment.
+    class bus_profile {
+    public:
+        std::vector<uint64_t> fetches;
+        std::vector<uint64_t> reads;
+        std::vector<uint64_t> writes;
+        size_t from_cycle; // the bus cycle the counting started at
+
+        explicit bus_profile(size_t cycle)
+        : fetches(0x10000), reads(0x10000), writes(0x10000), from_cycle(cycle)
+        {}
+
+        bus_profile(const bus_profile&) = delete;
+        bus_profile(bus_profile &&) = delete;
+        auto operator =(const bus_profile&)->bus_profile& = delete;
+        auto operator =(bus_profile &&)->bus_profile& = delete;
+
+        // The heatmap up to bus cycle 'now': the hottest pages, the hottest zero page addresses, the most polled I/O
+        // registers (the addresses in the pages with the devices' registers) and how deep the stack went in page 01.
+        // Every list has up to 'top' lines.
+        void report(std::ostream &stm, size_t now, const std::vector<REG8> &io_pages, size_t top = 16) const;
+    };
+}
+
+#endif
@@ -10,4 +10,13 @@ cpu::cpu(system_bus *bus, debugger *debugger)
 cpu::~cpu()
 {}
 
+bool cpu::run(size_t &cycles)
+{
+    while(cycles != 0 && !_bus->must_yield()) {
+        cycles--;
+        if (tick()) return true;
+    }
+    return false;
+}
+
 }
\ No newline at end of file
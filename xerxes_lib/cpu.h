@@ -22,6 +22,12 @@ namespace dave
 
         virtual void powerup() {}
         virtual bool tick() = 0;
+        // Run up to 'cycles' ticks, counting them down. Returns true (with cycles left) if the cpu must break. Also
+        // returns, with cycles left, when the bus asks the cpu to yield.
+        virtual bool run(size_t &cycles);
+        // The cycles of the loop the cpu idles in: a loop it goes round exactly the same way until an interupt, or
+        // until memory or a device changes (see system_bus::changes). 0 if the cpu isn't idling.
+        virtual size_t idle_period() { return 0; }
 
         virtual void report_status() {}
     };
@@ -1,5 +1,7 @@
 #include "cpu6502.h"
 
+#include <algorithm>
+
 #include "common.h"
 
 /*
@@ -222,6 +224,29 @@ namespace dave
             return addr;
         }
     };
+    // The next two bytes is the address of the address of the value "($D012)", only used by JMP
+    struct abs_ind {
+        static inline auto get_addr(system_bus *bus, cpu6502::registers &regs, int &cycles) -> REG16 {
+            REG16 ptr = abs::get_addr(bus, regs, cycles);
+            REG8 lo, hi;
+            bus->read(ptr, &lo);
+            ptr++;
+            bus->read(ptr, &hi);
+            return ((REG16)hi << 8) | (REG16)lo;
+        }
+    };
+    // The next two bytes is the address with offset x of the address of the value "($D012,X)", only used by JMP
+    struct abs_ind_x {
+        static inline auto get_addr(system_bus *bus, cpu6502::registers &regs, int &cycles) -> REG16 {
+            REG16 ptr = abs::get_addr(bus, regs, cycles);
+            ptr += regs.X;
+            REG8 lo, hi;
+            bus->read(ptr, &lo);
+            ptr++;
+            bus->read(ptr, &hi);
+            return ((REG16)hi << 8) | (REG16)lo;
+        }
+    };
     // The accumulator is used as the memory address
     struct acc {
     };
@@ -230,6 +255,10 @@ namespace dave
     // The Y register
     struct reg_y {};
 
+    inline auto is_neg(const REG8 &value) -> REG8 {
+        return (value & 0x80) == 0 ? 0 : 1;
+    }
+
     struct branch {
         template<typename _Pred> inline auto operator()(system_bus *bus, cpu6502::registers &regs, const _Pred &pred, int &cycles) const -> void {
             REG8 ofs;
@@ -253,21 +282,11 @@ namespace dave
             bus->read(_AM::get_addr(bus, regs, cycles), &m);
             regs.P.Z = (m == v ? 1 : 0);
             regs.P.C = (v < m ? 0 : 1);
-            // v - m
-            auto az = (v & 0x80) != 0;
-            if (az ^ ((m & 0x80) != 0)) {
-                regs.P.N = az;
-            }
-            else {
-                regs.P.N = ((SIGNED_REG8)v) < ((SIGNED_REG8)m) ? 1 : 0;
-            }
+            // N is bit 7 of v - m
+            regs.P.N = is_neg((REG8)(v - m));
         }
     };
 
-    inline auto is_neg(const REG8 &value) -> REG8 {
-        return (value & 0x80) == 0 ? 0 : 1;
-    }
-
     struct _incdec {
         template<typename _Action> inline auto operator()(cpu6502::registers &regs, REG8 &value, const _Action &action) -> void {
             action(value);
@@ -287,7 +306,8 @@ namespace dave
     };
     template<typename _Op, typename _AM> struct incdec {
         inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) -> void {
-            auto addr = _AM::get_addr(bus, regs, cycles);
+            int page_crossed = 0; // INC and DEC always take the cycle for the page crossing, it's in opcode_cycles
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
             REG8 m;
             bus->read(addr, &m);
             _Op()(regs, m);
@@ -345,8 +365,21 @@ namespace dave
         regs.S++;
         REG8 value;
         bus->read(0x0100 | regs.S, &value);
+        return value;
+    }
+
+    // The status register as it is pushed on the stack. B and the unused bit don't exist in the register; they are
+    // set when BRK or PHP pushes it, and B is clear when an interupt pushes it.
+    inline auto pushed_status(const cpu6502::registers &regs, bool brk) -> REG8 {
+        REG8 p = *((REG8*)&regs.P) | 0x20;
+        return brk ? p | 0x10 : p & ~0x10;
+    }
+
+    // Pull a value for A, X or Y, setting N and Z
+    inline auto stack_pull_reg(system_bus *bus, cpu6502::registers &regs) -> REG8 {
+        REG8 value = stack_pull(bus, regs);
         regs.P.N = is_neg(value);
-        regs.P.Z = value == 0;
+        regs.P.Z = value == 0 ? 1 : 0;
         return value;
     }
 
@@ -356,7 +389,7 @@ namespace dave
             UNPACK *p = (UNPACK*)&regs.PC;
             stack_push(bus, regs, p->hi);
             stack_push(bus, regs, p->lo);
-            stack_push(bus, regs, *((REG8*)&regs.P));
+            stack_push(bus, regs, pushed_status(regs, true));
             UNPACK *upc = (UNPACK*)&regs.PC;
             bus->read(0xFFFE, &upc->lo);
             bus->read(0xFFFF, &upc->hi);
@@ -366,53 +399,70 @@ namespace dave
         }
     };
 
-    template<typename _AM> struct adcsbc {
-    protected:
-        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles, const REG8 &m, REG8 &c) const -> void {
-            if (regs.P.D != 0) {
-                cycles++;
-            }
-            
-            REG16 res;
-            if (regs.P.D != 0) {
-                res = regs.A + 0x06;
-                auto t2 = res ^ m ^ c;                   // sum without carry propagation
-                res += m + c;                   // provisional sum
-                t2 = res ^ t2;                  // all the binary carry bits
-                t2 = ~t2 & 0x10;         // just the BCD carry bits
-                if (t2 != 0) {
-                    res -= 0x06; // corrected BCD sum
-                }
-            }
-            else {
-                res = regs.A + m + c;
-            }
+    // A + m + C, setting the flags. SBC adds the inverted value: A - m - borrow = A + ~m + C
+    inline auto binary_add(cpu6502::registers &regs, const REG8 &m) -> void {
+        REG16 res = regs.A + m + regs.P.C;
+        regs.P.V = ((regs.A ^ res) & (m ^ res) & 0x80) == 0 ? 0 : 1; // overflow when the sign bit was the same for A & M, and it's changed value.
+        regs.P.C = (res & 0x0100) == 0 ? 0 : 1;
+        res &= 0xFF;
+        regs.P.Z = res == 0 ? 1 : 0;
+        regs.P.N = is_neg((REG8)res);
+        regs.A = (REG8)res;
+    }
 
-            regs.P.V = ((regs.A ^ res) & (m ^ res) & 0x80) == 0 ? 0 : 1; // overflow when the sign bit was the same for A & M, and it's changed value.
-            c = (res & 0x0100) == 0 ? 0 : 1;
-            res &= 0xFF;
-            regs.P.Z = res == 0 ? 1 : 0;
-            regs.P.N = is_neg((REG8)res);
-            regs.A = (REG8)res;
-        }
-    };
-    template<typename _AM> struct adc : private adcsbc<_AM> {
+    // Decimal mode, as on the 65C02: A, m and the result are two BCD digits, C is the decimal carry, N and Z follow the
+    // result, and V is the overflow of the sum before the high digit is corrected.
+    inline auto decimal_adc(cpu6502::registers &regs, const REG8 &m) -> void {
+        int lo = (regs.A & 0x0F) + (m & 0x0F) + regs.P.C;
+        if (lo >= 0x0A) lo = ((lo + 0x06) & 0x0F) + 0x10;
+        int res = (regs.A & 0xF0) + (m & 0xF0) + lo;
+        regs.P.V = ((regs.A ^ res) & (m ^ res) & 0x80) == 0 ? 0 : 1;
+        if (res >= 0xA0) res += 0x60;
+        regs.P.C = res >= 0x100 ? 1 : 0;
+        regs.A = (REG8)res;
+        regs.P.Z = regs.A == 0 ? 1 : 0;
+        regs.P.N = is_neg(regs.A);
+    }
+
+    // Decimal mode SBC, as on the 65C02: C and V are the same as in binary mode, N and Z follow the BCD result
+    inline auto decimal_sbc(cpu6502::registers &regs, const REG8 &m) -> void {
+        int borrow = 1 - regs.P.C;
+        int lo = (regs.A & 0x0F) - (m & 0x0F) - borrow;
+        int bin = regs.A - m - borrow;
+        int res = bin;
+        if (res < 0) res -= 0x60;
+        if (lo < 0) res -= 0x06;
+        regs.P.C = bin < 0 ? 0 : 1;
+        regs.P.V = ((regs.A ^ m) & (regs.A ^ bin) & 0x80) == 0 ? 0 : 1;
+        regs.A = (REG8)res;
+        regs.P.Z = regs.A == 0 ? 1 : 0;
+        regs.P.N = is_neg(regs.A);
+    }
+
+    template<typename _AM> struct adc {
         inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
             REG8 m;
             bus->read(_AM::get_addr(bus, regs, cycles), &m);
-            REG8 c = regs.P.C;
-            adcsbc<_AM>::operator()(bus, regs, cycles, m, c);
-            regs.P.C = c;
+            if (regs.P.D == 0) {
+                binary_add(regs, m);
+            }
+            else {
+                cycles++;
+                decimal_adc(regs, m);
+            }
         }
     };
-    template<typename _AM> struct sbc : private adcsbc<_AM> {
+    template<typename _AM> struct sbc {
         inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
             REG8 m;
             bus->read(_AM::get_addr(bus, regs, cycles), &m);
-            m ^= 0xFF; // Flip every bit
-            REG8 c = !regs.P.C;
-            adcsbc<_AM>::operator()(bus, regs, cycles, m, c);
-            regs.P.C = !c;
+            if (regs.P.D == 0) {
+                binary_add(regs, m ^ 0xFF); // Flip every bit
+            }
+            else {
+                cycles++;
+                decimal_sbc(regs, m);
+            }
         }
     };
     template<typename _AM> struct asl {
@@ -572,7 +622,7 @@ namespace dave
             REG16 res = ((REG16)m) >> 1;
             res |= c;
             m = res & 0xFF;
-            regs.P.N = 0;
+            regs.P.N = is_neg(m);
             regs.P.Z = m == 0 ? 1 : 0;
             bus->write(addr, &m);
         }
@@ -584,29 +634,225 @@ namespace dave
             REG16 res = (REG16)regs.A >> 1;
             res |= c;
             res &= 0xFF;
-            regs.P.N = 0;
+            regs.P.N = is_neg((REG8)res);
             regs.P.Z = (res) == 0 ? 1 : 0;
             regs.A = (REG8)res;
         }
     };
     template<typename _AM> struct sta {
         inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
-            auto addr = _AM::get_addr(bus, regs, cycles);
+            int page_crossed = 0; // Stores always take the cycle for the page crossing, it's in opcode_cycles
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
             bus->write(addr, &regs.A);
         }
     };
     template<typename _AM> struct sty {
         inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
-            auto addr = _AM::get_addr(bus, regs, cycles);
+            int page_crossed = 0; // Stores always take the cycle for the page crossing, it's in opcode_cycles
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
             bus->write(addr, &regs.Y);
         }
     };
     template<typename _AM> struct stx {
         inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
-            auto addr = _AM::get_addr(bus, regs, cycles);
+            int page_crossed = 0; // Stores always take the cycle for the page crossing, it's in opcode_cycles
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
             bus->write(addr, &regs.X);
         }
     };
+    template<typename _AM> struct stz {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            int page_crossed = 0; // Stores always take the cycle for the page crossing, it's in opcode_cycles
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
+            REG8 zero = 0;
+            bus->write(addr, &zero);
+        }
+    };
+    // TSB and TRB set Z from A & M, then set (TSB) or clear (TRB) the bits of A in M
+    template<bool _Set, typename _AM> struct tsb_trb {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            auto addr = _AM::get_addr(bus, regs, cycles);
+            REG8 m;
+            bus->read(addr, &m);
+            regs.P.Z = (m & regs.A) == 0 ? 1 : 0;
+            m = _Set ? (m | regs.A) : (m & ~regs.A);
+            bus->write(addr, &m);
+        }
+    };
+    // An instruction that only takes its operand: the 65C02's unknown opcodes, and the NMOS NOPs
+    template<typename _AM> struct skip {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            _AM::get_addr(bus, regs, cycles);
+        }
+    };
+
+    // The undocumented NMOS 6502 instructions, for unknown_opcode_policy::nmos. SLO, RLA, SRE, RRA, DCP and ISC
+    // shift, rotate or count the value in memory, and then combine it with A.
+    struct shift_left {
+        inline auto operator()(cpu6502::registers &regs, REG8 &m) const -> void {
+            regs.P.C = m >> 7;
+            m <<= 1;
+        }
+    };
+    struct rotate_left {
+        inline auto operator()(cpu6502::registers &regs, REG8 &m) const -> void {
+            REG8 c = regs.P.C;
+            regs.P.C = m >> 7;
+            m = (m << 1) | c;
+        }
+    };
+    struct shift_right {
+        inline auto operator()(cpu6502::registers &regs, REG8 &m) const -> void {
+            regs.P.C = m & 0x01;
+            m >>= 1;
+        }
+    };
+    struct rotate_right {
+        inline auto operator()(cpu6502::registers &regs, REG8 &m) const -> void {
+            REG8 c = regs.P.C << 7;
+            regs.P.C = m & 0x01;
+            m = (m >> 1) | c;
+        }
+    };
+    template<typename _Op> struct combine_logic {
+        inline auto operator()(cpu6502::registers &regs, const REG8 &m) const -> void {
+            regs.A = _Op()(regs.A, m);
+            regs.P.N = is_neg(regs.A);
+            regs.P.Z = regs.A == 0 ? 1 : 0;
+        }
+    };
+    struct combine_adc {
+        inline auto operator()(cpu6502::registers &regs, const REG8 &m) const -> void {
+            if (regs.P.D == 0) binary_add(regs, m);
+            else decimal_adc(regs, m);
+        }
+    };
+    struct combine_sbc {
+        inline auto operator()(cpu6502::registers &regs, const REG8 &m) const -> void {
+            if (regs.P.D == 0) binary_add(regs, m ^ 0xFF);
+            else decimal_sbc(regs, m);
+        }
+    };
+    struct combine_cmp {
+        inline auto operator()(cpu6502::registers &regs, const REG8 &m) const -> void {
+            regs.P.Z = (m == regs.A ? 1 : 0);
+            regs.P.C = (regs.A < m ? 0 : 1);
+            regs.P.N = is_neg((REG8)(regs.A - m));
+        }
+    };
+    template<typename _Modify, typename _Combine, typename _AM> struct modify_combine {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            int page_crossed = 0; // Always taken, it's in nmos_opcode_cycles
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
+            REG8 m;
+            bus->read(addr, &m);
+            _Modify()(regs, m);
+            bus->write(addr, &m);
+            _Combine()(regs, m);
+        }
+    };
+    template<typename _AM> using slo = modify_combine<shift_left, combine_logic<logic_or>, _AM>;
+    template<typename _AM> using rla = modify_combine<rotate_left, combine_logic<logic_and>, _AM>;
+    template<typename _AM> using sre = modify_combine<shift_right, combine_logic<logic_eor>, _AM>;
+    template<typename _AM> using rra = modify_combine<rotate_right, combine_adc, _AM>;
+    template<typename _AM> using dcp = modify_combine<dec, combine_cmp, _AM>;
+    template<typename _AM> using isc = modify_combine<inc, combine_sbc, _AM>;
+    // A & X -> M, without changing the flags
+    template<typename _AM> struct sax {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            int page_crossed = 0;
+            auto addr = _AM::get_addr(bus, regs, page_crossed);
+            REG8 v = regs.A & regs.X;
+            bus->write(addr, &v);
+        }
+    };
+    // M -> A, X
+    template<typename _AM> struct lax {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            ld<_AM>()(bus, regs, regs.A, cycles);
+            regs.X = regs.A;
+        }
+    };
+    // M & S -> A, X, S
+    template<typename _AM> struct las {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            REG8 m;
+            bus->read(_AM::get_addr(bus, regs, cycles), &m);
+            regs.A = regs.X = regs.S = m & regs.S;
+            regs.P.N = is_neg(regs.A);
+            regs.P.Z = regs.A == 0 ? 1 : 0;
+        }
+    };
+    // AND #, then C = N
+    struct anc {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            logic<logic_and, imm>()(bus, regs, cycles);
+            regs.P.C = regs.P.N;
+        }
+    };
+    // AND #, then LSR A
+    struct alr {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            logic<logic_and, imm>()(bus, regs, cycles);
+            lsr<acc>()(bus, regs);
+        }
+    };
+    // AND #, then ROR A, with C and V from bits 6 and 5 of the result
+    struct arr {
+        inline auto operator()(system_bus *bus, cpu6502::registers &regs, int &cycles) const -> void {
+            logic<logic_and, imm>()(bus, regs, cycles);
+            ror<acc>()(bus, regs);
+            regs.P.C = (regs.A >> 6) & 0x01;
+            regs.P.V = ((regs.A >> 6) ^ (regs.A >> 5)) & 0x01;
+        }
+    };
+
+    // The cycles every opcode takes on a 65C02, before the extra cycles: +1 when a read (or ASL, LSR, ROL, ROR abs,X)
+    // crosses a page, +1 for a branch taken and +1 more when it lands on another page, +1 for ADC and SBC in decimal
+    // mode. Stores, INC and DEC always take the cycle for the page crossing, so it's in here. The opcodes without an
+    // instruction are the 65C02's NOPs: 1 cycle for x3, x7, xB and xF, 2 for x2, and 3, 4 or 8 for the others. WAI and
+    // STP take 3 cycles before the cpu sleeps.
+    static const REG8 opcode_cycles[256] = {
+    //  x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 xA xB xC xD xE xF
+        7, 6, 2, 1, 5, 3, 5, 1, 3, 2, 2, 1, 6, 4, 6, 1, // 0x
+        2, 5, 5, 1, 5, 4, 6, 1, 2, 4, 2, 1, 6, 4, 6, 1, // 1x
+        6, 6, 2, 1, 3, 3, 5, 1, 4, 2, 2, 1, 4, 4, 6, 1, // 2x
+        2, 5, 5, 1, 4, 4, 6, 1, 2, 4, 2, 1, 4, 4, 6, 1, // 3x
+        6, 6, 2, 1, 3, 3, 5, 1, 3, 2, 2, 1, 3, 4, 6, 1, // 4x
+        2, 5, 5, 1, 4, 4, 6, 1, 2, 4, 3, 1, 8, 4, 6, 1, // 5x
+        6, 6, 2, 1, 3, 3, 5, 1, 4, 2, 2, 1, 6, 4, 6, 1, // 6x
+        2, 5, 5, 1, 4, 4, 6, 1, 2, 4, 4, 1, 6, 4, 6, 1, // 7x
+        2, 6, 2, 1, 3, 3, 3, 1, 2, 2, 2, 1, 4, 4, 4, 1, // 8x
+        2, 6, 5, 1, 4, 4, 4, 1, 2, 5, 2, 1, 4, 5, 5, 1, // 9x
+        2, 6, 2, 1, 3, 3, 3, 1, 2, 2, 2, 1, 4, 4, 4, 1, // Ax
+        2, 5, 5, 1, 4, 4, 4, 1, 2, 4, 2, 1, 4, 4, 4, 1, // Bx
+        2, 6, 2, 1, 3, 3, 5, 1, 2, 2, 2, 3, 4, 4, 6, 1, // Cx
+        2, 5, 5, 1, 4, 4, 6, 1, 2, 4, 3, 3, 4, 4, 7, 1, // Dx
+        2, 6, 2, 1, 3, 3, 5, 1, 2, 2, 2, 1, 4, 4, 6, 1, // Ex
+        2, 5, 5, 1, 4, 4, 6, 1, 2, 4, 4, 1, 4, 4, 7, 1, // Fx
+    };
+
+    // The cycles the NMOS 6502 takes for the undocumented instructions in the opcodes without a 65C02 instruction,
+    // before +1 for a read crossing a page. 0 is a 65C02 instruction, and 1 is a JAM: the NMOS 6502 locks up.
+    static const REG8 nmos_opcode_cycles[256] = {
+    //  x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 xA xB xC xD xE xF
+        0, 0, 1, 8, 0, 0, 0, 5, 0, 0, 0, 2, 0, 0, 0, 6, // 0x
+        0, 0, 0, 8, 0, 0, 0, 6, 0, 0, 0, 7, 0, 0, 0, 7, // 1x
+        0, 0, 1, 8, 0, 0, 0, 5, 0, 0, 0, 2, 0, 0, 0, 6, // 2x
+        0, 0, 0, 8, 0, 0, 0, 6, 0, 0, 0, 7, 0, 0, 0, 7, // 3x
+        0, 0, 1, 8, 3, 0, 0, 5, 0, 0, 0, 2, 0, 0, 0, 6, // 4x
+        0, 0, 0, 8, 4, 0, 0, 6, 0, 0, 0, 7, 4, 0, 0, 7, // 5x
+        0, 0, 1, 8, 0, 0, 0, 5, 0, 0, 0, 2, 0, 0, 0, 6, // 6x
+        0, 0, 0, 8, 0, 0, 0, 6, 0, 0, 0, 7, 0, 0, 0, 7, // 7x
+        0, 0, 2, 6, 0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 4, // 8x
+        0, 0, 0, 6, 0, 0, 0, 4, 0, 0, 0, 5, 0, 0, 0, 5, // 9x
+        0, 0, 0, 6, 0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 4, // Ax
+        0, 0, 0, 5, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, // Bx
+        0, 0, 2, 8, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 6, // Cx
+        0, 0, 0, 8, 4, 0, 0, 6, 0, 0, 0, 0, 4, 0, 0, 7, // Dx
+        0, 0, 2, 8, 0, 0, 0, 5, 0, 0, 0, 2, 0, 0, 0, 6, // Ex
+        0, 0, 0, 8, 4, 0, 0, 6, 0, 0, 0, 7, 4, 0, 0, 7, // Fx
+    };
 
     cpu6502::cpu6502(system_bus *bus, debugger *debugger)
     : cpu(bus, debugger)
@@ -623,17 +869,51 @@ namespace dave
         _bus->read(0xFFFD, &upc->hi);
     }
 
+    bool cpu6502::run(size_t &cycles)
+    {
+        while(cycles != 0) {
+            // Skip the remaining cycles of the current operation in one go
+            if (_cycles_left_for_current_operation != 0) {
+                size_t skip = std::min(cycles, (size_t)_cycles_left_for_current_operation);
+                _cycles_left_for_current_operation -= (int)skip;
+                _cycles_run += skip;
+                cycles -= skip;
+                continue;
+            }
+            if (_bus->must_yield()) break;
+            cycles--;
+            if (cpu6502::tick()) return true;
+        }
+        return false;
+    }
+
     bool cpu6502::tick()
     {
+        _cycles_run++;
         if (_cycles_left_for_current_operation != 0) {
             _cycles_left_for_current_operation--;
             return false;
         }
 
+        // Asleep, the cpu doesn't fetch: STP ends on reset, WAI on any interupt, masked or not
+        if (_stopped) {
+            if (!_bus->reset) return false;
+            _stopped = false;
+        }
+        if (_waiting) {
+            if (!_bus->reset && !(_bus->nmi() && !_prev_nmi) && !_bus->irq()) return false;
+            _waiting = false;
+        }
+
         if (_debugger->break_on_next_instruction_ready(_registers.PC)) {
             return true;
         }
 
+        // The NMI is edge triggered: it fires when the line goes high, and again only after it went low
+        bool nmi_line = _bus->nmi();
+        bool nmi_edge = nmi_line && !_prev_nmi;
+        _prev_nmi = nmi_line;
+
         if (_bus->reset) {
             // the reset line is high - jump to the reset code
             _registers.S = 0xFF;
@@ -649,15 +929,14 @@ namespace dave
             _bus->read(0xFFFD, &upc->hi);
             return _debugger->break_on_reset();
         }
-        else if (_bus->nmi() && _prev_nmi == false)
+        else if (nmi_edge)
         {
             // Non-maskable interupt
             _cycles_left_for_current_operation = 6;
-            _prev_nmi = true;
             UNPACK *p = (UNPACK*)&_registers.PC;
             stack_push(_bus, _registers, p->hi);
             stack_push(_bus, _registers, p->lo);
-            stack_push(_bus, _registers, *((REG8*)&_registers.P));
+            stack_push(_bus, _registers, pushed_status(_registers, false));
             UNPACK *upc = (UNPACK*)&_registers.PC;
             _bus->read(0xFFFA, &upc->lo);
             _bus->read(0xFFFB, &upc->hi);
@@ -666,12 +945,11 @@ namespace dave
         }
         else {
             // Maskable interupt (unmasked)
-            _prev_nmi = false;
             if (_bus->irq() && _registers.P.I == 0) {
                 UNPACK *p = (UNPACK*)&_registers.PC;
                 stack_push(_bus, _registers, p->hi);
                 stack_push(_bus, _registers, p->lo);
-                stack_push(_bus, _registers, *((REG8*)&_registers.P));
+                stack_push(_bus, _registers, pushed_status(_registers, false));
                 UNPACK *upc = (UNPACK*)&_registers.PC;
                 _bus->read(0xFFFE, &upc->lo);
                 _bus->read(0xFFFF, &upc->hi);
@@ -681,581 +959,442 @@ namespace dave
             }
         }
 
+        REG16 at = _registers.PC;
         REG8 oc = 0;
-        _bus->read(_registers.PC, &oc);
+        _bus->fetch(_registers.PC, &oc);
         _registers.PC++;
+        // This cycle fetched the opcode. The instructions add their extra cycles (page crossings, branches taken and
+        // decimal mode) to the ones left.
+        _cycles_left_for_current_operation = opcode_cycles[oc] - 1;
         switch (oc) {
         case 0x00:
-            _cycles_left_for_current_operation = 6;
             brk()(_bus, _registers);
             return _debugger->break_on_break() || _debugger->break_after_instruction();
         case 0x69:
-            _cycles_left_for_current_operation = 1;
             adc<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x6D:
-            _cycles_left_for_current_operation = 3;
             adc<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x65:
-            _cycles_left_for_current_operation = 2;
             adc<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x61:
-            _cycles_left_for_current_operation = 5;
             adc<ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x71:
-            _cycles_left_for_current_operation = 4;
             adc<ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x75:
-            _cycles_left_for_current_operation = 3;
             adc<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x7D:
-            _cycles_left_for_current_operation = 3;
             adc<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x79:
-            _cycles_left_for_current_operation = 3;
             adc<abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x72:
-            _cycles_left_for_current_operation = 4;
             adc<ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE9:
-            _cycles_left_for_current_operation = 1;
             sbc<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xED:
-            _cycles_left_for_current_operation = 3;
             sbc<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE5:
-            _cycles_left_for_current_operation = 2;
             sbc<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE1:
-            _cycles_left_for_current_operation = 5;
             sbc<ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xF1:
-            _cycles_left_for_current_operation = 4;
             sbc<ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xF5:
-            _cycles_left_for_current_operation = 3;
             sbc<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xFD:
-            _cycles_left_for_current_operation = 3;
             sbc<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xF9:
-            _cycles_left_for_current_operation = 3;
             sbc<abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xF2:
-            _cycles_left_for_current_operation = 4;
             sbc<ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x29:
-            _cycles_left_for_current_operation = 1;
             logic<logic_and, imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x2D:
-            _cycles_left_for_current_operation = 3;
             logic<logic_and, abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x25:
-            _cycles_left_for_current_operation = 2;
             logic<logic_and, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x21:
-            _cycles_left_for_current_operation = 5;
             logic<logic_and, ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x31:
-            _cycles_left_for_current_operation = 4;
             logic<logic_and, ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x35:
-            _cycles_left_for_current_operation = 3;
             logic<logic_and, zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x3D:
-            _cycles_left_for_current_operation = 3;
             logic<logic_and, abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x39:
-            _cycles_left_for_current_operation = 3;
             logic<logic_and, abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x32:
-            _cycles_left_for_current_operation = 4;
             logic<logic_and, ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x0E:
-            _cycles_left_for_current_operation = 5;
             asl<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x06:
-            _cycles_left_for_current_operation = 4;
             asl<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x0A:
-            _cycles_left_for_current_operation = 1;
             asl<acc>()(_bus, _registers);
             break;
         case 0x16:
-            _cycles_left_for_current_operation = 5;
             asl<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x1E:
-            _cycles_left_for_current_operation = 5;
             asl<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x90: // bcc
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto& regs) { return regs.P.C == 0; }, _cycles_left_for_current_operation);
             break;
         case 0xB0: // bcs
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.C != 0; }, _cycles_left_for_current_operation);
             break;
         case 0xF0: // beq
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.Z != 0; }, _cycles_left_for_current_operation);
             break;
         case 0x30: // bmi
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.N != 0; }, _cycles_left_for_current_operation);
             break;
         case 0xD0: // bne
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.Z == 0; }, _cycles_left_for_current_operation);
             break;
         case 0x10: // bpl
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.N == 0; }, _cycles_left_for_current_operation);
             break;
         case 0x80: // bra
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return true; }, _cycles_left_for_current_operation);
             break;
         case 0x50: // bvc
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.V == 0; }, _cycles_left_for_current_operation);
             break;
         case 0x70: // bvs
-            _cycles_left_for_current_operation = 1;
             branch()(_bus, _registers, [](const auto &regs) { return regs.P.V != 0; }, _cycles_left_for_current_operation);
             break;
         case 0x89:
-            _cycles_left_for_current_operation = 1;
             bit<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x2C:
-            _cycles_left_for_current_operation = 3;
             bit<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x24: // bit
-            _cycles_left_for_current_operation = 2;
             bit<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x34:
-            _cycles_left_for_current_operation = 3;
             bit<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x3C:
-            _cycles_left_for_current_operation = 3;
             bit<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x18: // clc
-            _cycles_left_for_current_operation = 1;
             _registers.P.C = 0;
             break;
         case 0xD8: // cld
-            _cycles_left_for_current_operation = 1;
             _registers.P.D = 0;
             break;
         case 0x58: // cli
-            _cycles_left_for_current_operation = 1;
             _registers.P.I = 0;
             break;
         case 0xB8: // clv
-            _cycles_left_for_current_operation = 1;
             _registers.P.V = 0;
             break;
         case 0x38: // sec
-            _cycles_left_for_current_operation = 1;
             _registers.P.C = 1;
             break;
         case 0xF8: // sed
-            _cycles_left_for_current_operation = 1;
             _registers.P.D = 1;
             break;
         case 0x78: // sei
-            _cycles_left_for_current_operation = 1;
             _registers.P.I = 1;
             break;
         case 0xC9:
-            _cycles_left_for_current_operation = 1;
             cmp<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xCD:
-            _cycles_left_for_current_operation = 3;
             cmp<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xC5:
-            _cycles_left_for_current_operation = 2;
             cmp<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xC1:
-            _cycles_left_for_current_operation = 5;
             cmp<ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xD1:
-            _cycles_left_for_current_operation = 4;
             cmp<ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xD5:
-            _cycles_left_for_current_operation = 3;
             cmp<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xDD:
-            _cycles_left_for_current_operation = 3;
             cmp<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xD9:
-            _cycles_left_for_current_operation = 3;
             cmp<abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xD2:
-            _cycles_left_for_current_operation = 4;
             cmp<ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE0:
-            _cycles_left_for_current_operation = 1;
             cpx<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xEC:
-            _cycles_left_for_current_operation = 3;
             cpx<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE4:
-            _cycles_left_for_current_operation = 2;
             cpx<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xC0:
-            _cycles_left_for_current_operation = 1;
             cpy<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xCC:
-            _cycles_left_for_current_operation = 3;
             cpy<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xC4:
-            _cycles_left_for_current_operation = 2;
             cpy<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xCE:
-            _cycles_left_for_current_operation = 5;
             incdec<dec, abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xC6:
-            _cycles_left_for_current_operation = 4;
             incdec<dec, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x3A:
-            _cycles_left_for_current_operation = 1;
             incdec<dec, acc>()(_bus, _registers);
             break;
         case 0xD6:
-            _cycles_left_for_current_operation = 5;
             incdec<dec, zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xDE:
-            _cycles_left_for_current_operation = 5;
             incdec<dec, abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xCA:
-            _cycles_left_for_current_operation = 1;
             incdec<dec, reg_x>()(_bus, _registers);
             break;
         case 0x88:
-            _cycles_left_for_current_operation = 1;
             incdec<dec, reg_y>()(_bus, _registers);
             break;
         case 0xEE:
-            _cycles_left_for_current_operation = 5;
             incdec<inc, abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE6:
-            _cycles_left_for_current_operation = 4;
             incdec<inc, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x1A:
-            _cycles_left_for_current_operation = 1;
             incdec<inc, acc>()(_bus, _registers);
             break;
         case 0xF6:
-            _cycles_left_for_current_operation = 5;
             incdec<inc, zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xFE:
-            _cycles_left_for_current_operation = 5;
             incdec<inc, abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xE8:
-            _cycles_left_for_current_operation = 1;
             incdec<inc, reg_x>()(_bus, _registers);
             break;
         case 0xC8:
-            _cycles_left_for_current_operation = 1;
             incdec<inc, reg_y>()(_bus, _registers);
             break;
         case 0x49:
-            _cycles_left_for_current_operation = 1;
             logic<logic_eor, imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x4D:
-            _cycles_left_for_current_operation = 3;
             logic<logic_eor, abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x45:
-            _cycles_left_for_current_operation = 2;
             logic<logic_eor, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x41:
-            _cycles_left_for_current_operation = 5;
             logic<logic_eor, ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x51:
-            _cycles_left_for_current_operation = 4;
             logic<logic_eor, ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x55:
-            _cycles_left_for_current_operation = 3;
             logic<logic_eor, zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x5D:
-            _cycles_left_for_current_operation = 3;
             logic<logic_eor, abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x59:
-            _cycles_left_for_current_operation = 3;
             logic<logic_eor, abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x52:
-            _cycles_left_for_current_operation = 4;
             logic<logic_eor, ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x4C:
-            _cycles_left_for_current_operation = 2;
             jmp<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x7C:
-            _cycles_left_for_current_operation = 5;
-            jmp<ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
+            jmp<abs_ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x6C:
-            _cycles_left_for_current_operation = 5;
-            jmp<ind>()(_bus, _registers, _cycles_left_for_current_operation);
+            jmp<abs_ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x20:
-            _cycles_left_for_current_operation = 5;
             jsr<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA9:
-            _cycles_left_for_current_operation = 1;
             lda<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xAD:
-            _cycles_left_for_current_operation = 3;
             lda<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA5:
-            _cycles_left_for_current_operation = 2;
             lda<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA1:
-            _cycles_left_for_current_operation = 5;
             lda<ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xB1:
-            _cycles_left_for_current_operation = 4;
             lda<ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xB5:
-            _cycles_left_for_current_operation = 3;
             lda<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xBD:
-            _cycles_left_for_current_operation = 3;
             lda<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xB9:
-            _cycles_left_for_current_operation = 3;
             lda<abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xB2:
-            _cycles_left_for_current_operation = 4;
             lda<ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA2:
-            _cycles_left_for_current_operation = 1;
             ldx<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xAE:
-            _cycles_left_for_current_operation = 3;
             ldx<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA6:
-            _cycles_left_for_current_operation = 2;
             ldx<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xBE:
-            _cycles_left_for_current_operation = 3;
             ldx<abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xB6:
-            _cycles_left_for_current_operation = 3;
             ldx<zpg_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA0:
-            _cycles_left_for_current_operation = 1;
             ldy<imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xAC:
-            _cycles_left_for_current_operation = 3;
             ldy<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xA4:
-            _cycles_left_for_current_operation = 2;
             ldy<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xB4:
-            _cycles_left_for_current_operation = 3;
             ldy<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xBC:
-            _cycles_left_for_current_operation = 3;
             ldy<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x4E:
-            _cycles_left_for_current_operation = 5;
             lsr<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x46:
-            _cycles_left_for_current_operation = 4;
             lsr<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x4A:
-            _cycles_left_for_current_operation = 1;
             lsr<acc>()(_bus, _registers);
             break;
         case 0x56:
-            _cycles_left_for_current_operation = 5;
             lsr<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x5E:
-            _cycles_left_for_current_operation = 5;
             lsr<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xEA: // nop
-            _cycles_left_for_current_operation = 1;
             break;
         case 0x09:
-            _cycles_left_for_current_operation = 1;
             logic<logic_or, imm>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x0D:
-            _cycles_left_for_current_operation = 3;
             logic<logic_or, abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x05:
-            _cycles_left_for_current_operation = 2;
             logic<logic_or, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x01:
-            _cycles_left_for_current_operation = 5;
             logic<logic_or, ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x11:
-            _cycles_left_for_current_operation = 4;
             logic<logic_or, ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x15:
-            _cycles_left_for_current_operation = 3;
             logic<logic_or, zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x1D:
-            _cycles_left_for_current_operation = 3;
             logic<logic_or, abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x19:
-            _cycles_left_for_current_operation = 3;
             logic<logic_or, abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x12:
-            _cycles_left_for_current_operation = 4;
             logic<logic_or, ind>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x48: // PHA
-            _cycles_left_for_current_operation = 2;
             stack_push(_bus, _registers, _registers.A);
             break;
         case 0x08:
-            _cycles_left_for_current_operation = 2;
-            stack_push(_bus, _registers, *((REG8*)&_registers.P));
+            stack_push(_bus, _registers, pushed_status(_registers, true));
             break;
         case 0xDA:
-            _cycles_left_for_current_operation = 2;
             stack_push(_bus, _registers, _registers.X);
             break;
         case 0x68:
-            _cycles_left_for_current_operation = 3;
-            _registers.A = stack_pull(_bus, _registers);
+            _registers.A = stack_pull_reg(_bus, _registers);
             break;
         case 0x28:
-            _cycles_left_for_current_operation = 3;
-            *((REG8*)&_registers.P) = stack_pull(_bus, _registers);
+            *((REG8*)&_registers.P) = stack_pull(_bus, _registers) & 0xCF; // B and the unused bit aren't in the register
             break;
         case 0xFA:
-            _cycles_left_for_current_operation = 3;
-            _registers.X = stack_pull(_bus, _registers);
+            _registers.X = stack_pull_reg(_bus, _registers);
             break;
         case 0x7A:
-            _cycles_left_for_current_operation = 3;
-            _registers.Y = stack_pull(_bus, _registers);
+            _registers.Y = stack_pull_reg(_bus, _registers);
             break;
         case 0x2A:
-            _cycles_left_for_current_operation = 1;
             rol<acc>()(_bus, _registers);
             break;
         case 0x26:
-            _cycles_left_for_current_operation = 4;
             rol<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x36:
-            _cycles_left_for_current_operation = 5;
             rol<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x2E:
-            _cycles_left_for_current_operation = 5;
             rol<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x3E:
-            _cycles_left_for_current_operation = 6;
             rol<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x40: // RTI (Return from interupt)
             if (true) {
-                _cycles_left_for_current_operation = 5;
-                *((REG8*)&_registers.P) = stack_pull(_bus, _registers);
+                *((REG8*)&_registers.P) = stack_pull(_bus, _registers) & 0xCF; // B and the unused bit aren't in the register
                 UNPACK *p = (UNPACK*)&_registers.PC;
                 p->lo = stack_pull(_bus, _registers);
                 p->hi = stack_pull(_bus, _registers);    
@@ -1263,7 +1402,6 @@ namespace dave
             break;
         case 0x60: // RTS (Return from subroutine)
             if (true) {
-                _cycles_left_for_current_operation = 5;
                 UNPACK *p = (UNPACK*)&_registers.PC;
                 p->lo = stack_pull(_bus, _registers);
                 p->hi = stack_pull(_bus, _registers);
@@ -1271,112 +1409,275 @@ namespace dave
             }
             break;
         case 0x6A:
-            _cycles_left_for_current_operation = 1;
             ror<acc>()(_bus, _registers);
             break;
         case 0x66:
-            _cycles_left_for_current_operation = 4;
             ror<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x76:
-            _cycles_left_for_current_operation = 5;
             ror<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x6E:
-            _cycles_left_for_current_operation = 5;
             ror<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x7E:
-            _cycles_left_for_current_operation = 6;
             ror<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x85:
-            _cycles_left_for_current_operation = 2;
             sta<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x95:
-            _cycles_left_for_current_operation = 3;
             sta<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x8D:
-            _cycles_left_for_current_operation = 3;
             sta<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x9D:
-            _cycles_left_for_current_operation = 4;
             sta<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x99:
-            _cycles_left_for_current_operation = 4;
             sta<abs_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x81:
-            _cycles_left_for_current_operation = 5;
             sta<ind_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x91:
-            _cycles_left_for_current_operation = 5;
             sta<ind_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x84:
-            _cycles_left_for_current_operation = 2;
             sty<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x94:
-            _cycles_left_for_current_operation = 3;
             sty<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x8C:
-            _cycles_left_for_current_operation = 3;
             sty<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x86:
-            _cycles_left_for_current_operation = 2;
             stx<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x96:
-            _cycles_left_for_current_operation = 3;
-            stx<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
+            stx<zpg_y>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0x8E:
-            _cycles_left_for_current_operation = 3;
             stx<abs>()(_bus, _registers, _cycles_left_for_current_operation);
             break;
         case 0xAA: // TAX
-            _cycles_left_for_current_operation = 1;
             _registers.X = _registers.A;
             _registers.P.N = is_neg(_registers.X);
+            _registers.P.Z = _registers.X == 0 ? 1 : 0;
             break;
         case 0x8A: // TXA
-            _cycles_left_for_current_operation = 1;
             _registers.A = _registers.X;
             _registers.P.N = is_neg(_registers.A);
+            _registers.P.Z = _registers.A == 0 ? 1 : 0;
             break;
         case 0xA8: // TAY
-            _cycles_left_for_current_operation = 1;
             _registers.Y = _registers.A;
             _registers.P.N = is_neg(_registers.Y);
+            _registers.P.Z = _registers.Y == 0 ? 1 : 0;
             break;
         case 0x98: // TYA
-            _cycles_left_for_current_operation = 1;
             _registers.A = _registers.Y;
             _registers.P.N = is_neg(_registers.A);
+            _registers.P.Z = _registers.A == 0 ? 1 : 0;
             break;
         case 0xBA: // TSX
-            _cycles_left_for_current_operation = 1;
             _registers.X = _registers.S;
             _registers.P.N = is_neg(_registers.X);
+            _registers.P.Z = _registers.X == 0 ? 1 : 0;
             break;
         case 0x9A: // TXS
-            _cycles_left_for_current_operation = 1;
             _registers.S = _registers.X;
-            _registers.P.N = is_neg(_registers.S);
+            break;
+        case 0x5A: // PHY
+            stack_push(_bus, _registers, _registers.Y);
+            break;
+        case 0x64:
+            stz<zpg>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x74:
+            stz<zpg_x>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x9C:
+            stz<abs>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x9E:
+            stz<abs_x>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x92:
+            sta<ind>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x04:
+            tsb_trb<true, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x0C:
+            tsb_trb<true, abs>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x14:
+            tsb_trb<false, zpg>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0x1C:
+            tsb_trb<false, abs>()(_bus, _registers, _cycles_left_for_current_operation);
+            break;
+        case 0xCB: // WAI
+            _waiting = true;
+            break;
+        case 0xDB: // STP
+            _stopped = true;
+            return _debugger->break_on_stop(at);
+        default:
+            if (!run_unknown_opcode(oc)) {
+                return _debugger->break_on_unknown_opcode(_registers.PC, oc);
+            }
             break;
         }
+        if (_registers.PC <= at) {
+            jumped_back(at);
+        }
 
         return _debugger->break_after_instruction();
     }
 
+    // A jump back may close an idle loop: when the cpu is back in the state the same jump left it in the last time,
+    // without a write, device event or interupt in between, it will go round the same way until one
+    void cpu6502::jumped_back(const REG16 &from)
+    {
+        auto cycle = _cycles_run + _cycles_left_for_current_operation;
+        auto changes = _bus->changes();
+        auto &last = _last_jump_back;
+        bool same = last.from == from && last.changes == changes
+            && last.regs.PC == _registers.PC && last.regs.A == _registers.A && last.regs.X == _registers.X
+            && last.regs.Y == _registers.Y && last.regs.S == _registers.S
+            && *((REG8*)&last.regs.P) == *((REG8*)&_registers.P);
+        _idle_period = same ? cycle - last.cycle : 0;
+        last = jump_back { from, _registers, cycle, changes };
+    }
+
+    size_t cpu6502::idle_period()
+    {
+        // Asleep, once WAI or STP took its cycles, every cycle is the same until reset (or an interupt, after WAI)
+        if (_waiting || _stopped) {
+            if (_cycles_left_for_current_operation != 0 || _bus->reset) return 0;
+            return _stopped || !((_bus->nmi() && !_prev_nmi) || _bus->irq()) ? 1 : 0;
+        }
+        if (_idle_period == 0 || _last_jump_back.changes != _bus->changes()) {
+            return 0;
+        }
+        // An interupt the cpu is about to take ends the loop
+        if (_bus->reset || (_bus->nmi() && !_prev_nmi) || (_bus->irq() && _registers.P.I == 0)) {
+            return 0;
+        }
+        return _idle_period;
+    }
+
+    // Run an opcode without a 65C02 instruction, according to the policy. Returns false when the cpu stops on it,
+    // with the PC back on the opcode.
+    auto cpu6502::run_unknown_opcode(const REG8 &oc) -> bool
+    {
+        auto &cycles = _cycles_left_for_current_operation;
+        if (_unknown_opcodes == unknown_opcode_policy::halt || (_unknown_opcodes == unknown_opcode_policy::nmos && nmos_opcode_cycles[oc] == 1)) {
+            _registers.PC--;
+            cycles = 0;
+            return false;
+        }
+        if (_unknown_opcodes == unknown_opcode_policy::nmos && nmos_opcode_cycles[oc] != 0) {
+            cycles = nmos_opcode_cycles[oc] - 1;
+            switch(oc) {
+            case 0x03: slo<ind_x>()(_bus, _registers, cycles); return true;
+            case 0x13: slo<ind_y>()(_bus, _registers, cycles); return true;
+            case 0x07: slo<zpg>()(_bus, _registers, cycles); return true;
+            case 0x17: slo<zpg_x>()(_bus, _registers, cycles); return true;
+            case 0x0F: slo<abs>()(_bus, _registers, cycles); return true;
+            case 0x1F: slo<abs_x>()(_bus, _registers, cycles); return true;
+            case 0x1B: slo<abs_y>()(_bus, _registers, cycles); return true;
+            case 0x23: rla<ind_x>()(_bus, _registers, cycles); return true;
+            case 0x33: rla<ind_y>()(_bus, _registers, cycles); return true;
+            case 0x27: rla<zpg>()(_bus, _registers, cycles); return true;
+            case 0x37: rla<zpg_x>()(_bus, _registers, cycles); return true;
+            case 0x2F: rla<abs>()(_bus, _registers, cycles); return true;
+            case 0x3F: rla<abs_x>()(_bus, _registers, cycles); return true;
+            case 0x3B: rla<abs_y>()(_bus, _registers, cycles); return true;
+            case 0x43: sre<ind_x>()(_bus, _registers, cycles); return true;
+            case 0x53: sre<ind_y>()(_bus, _registers, cycles); return true;
+            case 0x47: sre<zpg>()(_bus, _registers, cycles); return true;
+            case 0x57: sre<zpg_x>()(_bus, _registers, cycles); return true;
+            case 0x4F: sre<abs>()(_bus, _registers, cycles); return true;
+            case 0x5F: sre<abs_x>()(_bus, _registers, cycles); return true;
+            case 0x5B: sre<abs_y>()(_bus, _registers, cycles); return true;
+            case 0x63: rra<ind_x>()(_bus, _registers, cycles); return true;
+            case 0x73: rra<ind_y>()(_bus, _registers, cycles); return true;
+            case 0x67: rra<zpg>()(_bus, _registers, cycles); return true;
+            case 0x77: rra<zpg_x>()(_bus, _registers, cycles); return true;
+            case 0x6F: rra<abs>()(_bus, _registers, cycles); return true;
+            case 0x7F: rra<abs_x>()(_bus, _registers, cycles); return true;
+            case 0x7B: rra<abs_y>()(_bus, _registers, cycles); return true;
+            case 0xC3: dcp<ind_x>()(_bus, _registers, cycles); return true;
+            case 0xD3: dcp<ind_y>()(_bus, _registers, cycles); return true;
+            case 0xC7: dcp<zpg>()(_bus, _registers, cycles); return true;
+            case 0xD7: dcp<zpg_x>()(_bus, _registers, cycles); return true;
+            case 0xCF: dcp<abs>()(_bus, _registers, cycles); return true;
+            case 0xDF: dcp<abs_x>()(_bus, _registers, cycles); return true;
+            case 0xE3: isc<ind_x>()(_bus, _registers, cycles); return true;
+            case 0xF3: isc<ind_y>()(_bus, _registers, cycles); return true;
+            case 0xE7: isc<zpg>()(_bus, _registers, cycles); return true;
+            case 0xF7: isc<zpg_x>()(_bus, _registers, cycles); return true;
+            case 0xEF: isc<abs>()(_bus, _registers, cycles); return true;
+            case 0xFF: isc<abs_x>()(_bus, _registers, cycles); return true;
+            case 0xFB: isc<abs_y>()(_bus, _registers, cycles); return true;
+            case 0x83: sax<ind_x>()(_bus, _registers, cycles); return true;
+            case 0x87: sax<zpg>()(_bus, _registers, cycles); return true;
+            case 0x97: sax<zpg_y>()(_bus, _registers, cycles); return true;
+            case 0x8F: sax<abs>()(_bus, _registers, cycles); return true;
+            case 0xA3: lax<ind_x>()(_bus, _registers, cycles); return true;
+            case 0xB3: lax<ind_y>()(_bus, _registers, cycles); return true;
+            case 0xA7: lax<zpg>()(_bus, _registers, cycles); return true;
+            case 0xB7: lax<zpg_y>()(_bus, _registers, cycles); return true;
+            case 0xAF: lax<abs>()(_bus, _registers, cycles); return true;
+            case 0xBF: lax<abs_y>()(_bus, _registers, cycles); return true;
+            case 0xBB: las<abs_y>()(_bus, _registers, cycles); return true;
+            case 0x0B:
+            case 0x2B: anc()(_bus, _registers, cycles); return true;
+            case 0x4B: alr()(_bus, _registers, cycles); return true;
+            case 0x6B: arr()(_bus, _registers, cycles); return true;
+            case 0xEB: sbc<imm>()(_bus, _registers, cycles); return true;
+            case 0x5C:
+            case 0xDC:
+            case 0xFC: skip<abs_x>()(_bus, _registers, cycles); return true;
+            // XAA, LAX #, AHX and TAS are unstable: what they do depends on the chip, so they only take their operand
+            case 0x8B:
+            case 0xAB: skip<imm>()(_bus, _registers, cycles); return true;
+            case 0x93: skip<zpg>()(_bus, _registers, cycles); return true;
+            case 0x9B:
+            case 0x9F: skip<abs>()(_bus, _registers, cycles); return true;
+            }
+            // NOP #, NOP zp and NOP zp,X are as long as the 65C02's NOPs in their place
+        }
+        // The 65C02's NOPs, of one to three bytes
+        int page_crossed = 0;
+        switch(oc) {
+        case 0x02: case 0x22: case 0x42: case 0x62: case 0x82: case 0xC2: case 0xE2:
+            skip<imm>()(_bus, _registers, page_crossed);
+            break;
+        case 0x44: case 0x54: case 0xD4: case 0xF4:
+            skip<zpg>()(_bus, _registers, page_crossed);
+            break;
+        case 0x5C: case 0xDC: case 0xFC:
+            skip<abs>()(_bus, _registers, page_crossed);
+            break;
+        }
+        return true;
+    }
+
+    auto try_parse_unknown_opcode_policy(const std::string &name, cpu6502::unknown_opcode_policy &policy) -> bool
+    {
+        if (name == "nop") policy = cpu6502::unknown_opcode_policy::nop;
+        else if (name == "halt") policy = cpu6502::unknown_opcode_policy::halt;
+        else if (name == "nmos") policy = cpu6502::unknown_opcode_policy::nmos;
+        else return false;
+        return true;
+    }
+
     void cpu6502::report_status()
     {
         _debugger->report_cpu_register("PC", _registers.PC);
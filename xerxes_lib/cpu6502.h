@@ -1,6 +1,8 @@
 #ifndef __CPU6502H
 #define __CPU6502H
 
+#include <string>
+
 #include "system_bus.h"
 #include "cpu.h"
 
@@ -23,6 +25,31 @@ namespace dave
         };
 
         registers _registers;
+
+        // What the cpu does with an opcode that isn't a 65C02 instruction
+        enum class unknown_opcode_policy {
+            nop,  // skip it, taking the bytes and cycles the 65C02 gives it
+            halt, // stop on it, and ask the debugger whether to break; the cpu doesn't get past it
+            nmos  // run the undocumented instruction the NMOS 6502 has in its place
+        };
+        unknown_opcode_policy _unknown_opcodes = unknown_opcode_policy::nop;
+    private:
+        // Idle loop detection: the last jump back (or to itself), and the state it jumped back to
+        struct jump_back {
+            REG16 from;
+            registers regs;
+            size_t cycle;
+            size_t changes;
+        };
+        size_t _cycles_run = 0;
+        jump_back _last_jump_back = {};
+        size_t _idle_period = 0;
+        // WAI: asleep until an interupt line goes high. STP: asleep until reset.
+        bool _waiting = false;
+        bool _stopped = false;
+
+        auto run_unknown_opcode(const REG8 &oc) -> bool;
+        void jumped_back(const REG16 &from);
     public:
         cpu6502() = delete;
         cpu6502(const cpu6502&) = delete;
@@ -34,9 +61,16 @@ namespace dave
 
         virtual void powerup() override;
         virtual bool tick() override;
+        virtual bool run(size_t &cycles) override;
+        virtual size_t idle_period() override;
+        // Whether WAI or STP put the cpu to sleep
+        auto asleep() const -> bool { return _waiting || _stopped; }
 
         virtual void report_status() override;
     };
+
+    // "nop", "halt" or "nmos"
+    auto try_parse_unknown_opcode_policy(const std::string &name, cpu6502::unknown_opcode_policy &policy) -> bool;
 }
 
 #endif
\ No newline at end of file
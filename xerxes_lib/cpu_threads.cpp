@@ -0,0 +1,58 @@
+#include "cpu_threads.h"
+
+namespace dave
+{
+
+cpu_threads::cpu_threads(size_t count)
+{
+    for(size_t i = 1; i < count; i++) {
+        _threads.emplace_back(&cpu_threads::work, this, i);
+    }
+}
+
+cpu_threads::~cpu_threads()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+    }
+    _start.notify_all();
+    for(auto &t : _threads) {
+        t.join();
+    }
+}
+
+void cpu_threads::work(size_t index)
+{
+    size_t generation = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _start.wait(guard, [&]() { return _stop || _generation != generation; });
+            if (_stop) return;
+            generation = _generation;
+        }
+        _round(index);
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _running--;
+        }
+        _done.notify_one();
+    }
+}
+
+void cpu_threads::run(const std::function<void(size_t)> &round)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _round = round;
+        _running = _threads.size();
+        _generation++;
+    }
+    _start.notify_all();
+    round(0);
+    std::unique_lock<std::mutex> guard(_lock);
+    _done.wait(guard, [&]() { return _running == 0; });
+}
+
+}
@@ -0,0 +1,42 @@
+#ifndef __CPU_THREADSH
+#define __CPU_THREADSH
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dave
+{
+    // A host thread per cpu, kept alive between rounds. run() hands every thread its index, runs index 0 on the
+    // calling thread, and returns once they have all completed.
+    class cpu_threads {
+    private:
+        std::vector<std::thread> _threads;
+        std::mutex _lock;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        std::function<void(size_t)> _round;
+        size_t _generation = 0;
+        size_t _running = 0;
+        bool _stop = false;
+
+        void work(size_t index);
+    public:
+        explicit cpu_threads(size_t count);
+        ~cpu_threads();
+
+        cpu_threads(const cpu_threads&) = delete;
+        cpu_threads(cpu_threads &&) = delete;
+        auto operator =(const cpu_threads&)->cpu_threads& = delete;
+        auto operator =(cpu_threads &&)->cpu_threads& = delete;
+
+        auto count() const -> size_t { return _threads.size() + 1; }
+
+        void run(const std::function<void(size_t)> &round);
+    };
+}
+
+#endif
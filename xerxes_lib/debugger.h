@@ -19,6 +19,9 @@ namespace dave
         virtual bool break_on_nmi() = 0;
         virtual bool break_on_interupt() = 0;
         virtual bool break_on_break() = 0;
+        virtual bool break_on_unknown_opcode(const REG16 &addr, const REG8 &opcode) = 0;
+        // STP at addr: the cpu sleeps until reset
+        virtual bool break_on_stop(const REG16 &addr) = 0;
         virtual bool break_asap() = 0;
         virtual bool break_on_bus_address_changed(const REG16 &addr) = 0;
 
@@ -26,6 +29,11 @@ namespace dave
         virtual void report_cpu_register(const std::string &name, const uint16_t &value) = 0;
         virtual void report_cpu_register(const std::string &name, const bool &value) = 0;
         virtual void tick() = 0;
+        virtual void tick(size_t count) {
+            while(count--) tick();
+        }
+        // The most cycles the bus may skip in a single tick while the cpu idles (see system_bus::skip_idle)
+        virtual size_t idle_cycles_allowed() { return SIZE_MAX; }
         virtual void report_address_write(const REG16 &addr, const REG8 *data) = 0;
 
         virtual void report_nmi_line(bool value) = 0;
@@ -25,11 +25,18 @@ namespace dave
 
         virtual bool irq() { return false; }
         virtual bool nmi() { return false; }
-        virtual void tick() {}
+        // An event the device scheduled on the bus is due. Devices don't tick: whatever takes time waits on the bus's
+        // event schedule (see system_bus::schedule).
+        virtual void event(size_t tag) {}
         virtual void powerup() {}
         virtual void nop() = 0;
         virtual void write(const REG16 &address, const REG8 *data) = 0;
         virtual void read(const REG16 &address, REG8 *dest) = 0;
+
+        // Whether the device responds to addresses in the page. Devices that don't say respond to every page.
+        virtual bool decodes(REG8 page) { return true; }
+        // The bytes of a page the device backs with plain memory, or nullptr
+        virtual REG8* direct(REG8 page) { return nullptr; }
     };
 }
 
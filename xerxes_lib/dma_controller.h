@@ -0,0 +1,162 @@
+#ifndef __DMA_CONTROLLERH
+#define __DMA_CONTROLLERH
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dave
+{
+    // Copies or fills blocks of memory for the cpu. Registers, from _Base:
+    //   +0: source (lo, hi at +1), for a fill the lo byte is the value to fill with
+    //   +2: destination (lo, hi at +3)
+    //   +4: length (lo, hi at +5)
+    //   +6: mode (0 = copy, 1 = fill)
+    //   +7: write 01 to start; read for the status (0 = ready, 1 = busy, 2 = done)
+    // The transfer takes effect once the cycles it costs have passed, when the controller raises an IRQ. Reading
+    // the status clears the IRQ. A copy runs front to back, as a byte at a time loop would. Pages only plain memory
+    // backs are copied with memcpy/memset, everything else goes through the bus.
+    template<REG16 _Base> class dma_controller : public device {
+    public:
+        enum class mode {
+            copy = 0x00,
+            fill = 0x01
+        };
+        enum class status {
+            ready = 0x00,
+            busy = 0x01,
+            done = 0x02
+        };
+    private:
+        size_t _cycles_per_byte;
+        size_t _setup_cycles;
+
+        bool _irq;
+        bool _busy;
+        size_t _generation; // tags the scheduled completion
+        REG8 _status;
+        REG16 _source;
+        REG16 _destination;
+        REG16 _length;
+        REG8 _mode;
+
+        void copy(REG16 src, REG16 dst, size_t length) {
+            while(length > 0) {
+                // Up to the end of the source or destination page
+                size_t chunk = std::min(length, (size_t)std::min(0x100 - (src & 0xFF), 0x100 - (dst & 0xFF)));
+                auto from = _bus->direct((REG8)(src >> 8));
+                auto to = _bus->direct((REG8)(dst >> 8));
+                bool overlap = dst > src && dst < src + chunk;
+                if (from != nullptr && to != nullptr && !overlap) {
+                    std::memmove(to + (dst & 0xFF), from + (src & 0xFF), chunk);
+                }
+                else {
+                    for(size_t i = 0; i < chunk; i++) {
+                        REG8 b = 0;
+                        _bus->read((REG16)(src + i), &b);
+                        _bus->write((REG16)(dst + i), &b);
+                    }
+                }
+                src += (REG16)chunk;
+                dst += (REG16)chunk;
+                length -= chunk;
+            }
+        }
+
+        void fill(REG16 dst, REG8 value, size_t length) {
+            while(length > 0) {
+                size_t chunk = std::min(length, (size_t)(0x100 - (dst & 0xFF)));
+                auto to = _bus->direct((REG8)(dst >> 8));
+                if (to != nullptr) {
+                    std::memset(to + (dst & 0xFF), value, chunk);
+                }
+                else {
+                    for(size_t i = 0; i < chunk; i++) {
+                        _bus->write((REG16)(dst + i), &value);
+                    }
+                }
+                dst += (REG16)chunk;
+                length -= chunk;
+            }
+        }
+
+        void complete() {
+            if ((mode)_mode == mode::fill) {
+                fill(_destination, (REG8)(_source & 0xFF), _length);
+            }
+            else {
+                copy(_source, _destination, _length);
+            }
+            _status = (REG8)status::done;
+            _irq = true;
+        }
+
+        void set_lo(REG16 &reg, REG8 value) { reg = (reg & 0xFF00) | value; }
+        void set_hi(REG16 &reg, REG8 value) { reg = (reg & 0x00FF) | ((REG16)value << 8); }
+    public:
+        // A transfer costs the setup cycles, plus the cycles per byte
+        dma_controller(system_bus *bus, debugger *debugger, size_t cycles_per_byte = 1, size_t setup_cycles = 4)
+            : device(bus, debugger), _cycles_per_byte(cycles_per_byte), _setup_cycles(setup_cycles),
+              _irq(false), _busy(false), _generation(0), _status(0), _source(0), _destination(0), _length(0), _mode(0)
+        {}
+        dma_controller() = delete;
+        dma_controller(const dma_controller&) = delete;
+        dma_controller(dma_controller &&) = delete;
+        auto operator =(const dma_controller&)->dma_controller& = delete;
+        auto operator =(dma_controller &&)->dma_controller& = delete;
+
+        virtual bool irq() override { return _irq; }
+        virtual void event(size_t tag) override {
+            if (tag != _generation || !_busy) return;
+            _busy = false;
+            complete();
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            switch(address) {
+                case _Base + 0: set_lo(_source, *data); break;
+                case _Base + 1: set_hi(_source, *data); break;
+                case _Base + 2: set_lo(_destination, *data); break;
+                case _Base + 3: set_hi(_destination, *data); break;
+                case _Base + 4: set_lo(_length, *data); break;
+                case _Base + 5: set_hi(_length, *data); break;
+                case _Base + 6: _mode = *data; break;
+                case _Base + 7:
+                    if (*data == 0x01 && !_busy) {
+                        _irq = false;
+                        _status = (REG8)status::busy;
+                        _busy = true;
+                        // At least a tick, the transfer never happens inside the bus write that starts it
+                        _bus->schedule(this, std::max((size_t)1, _setup_cycles + _cycles_per_byte * _length), ++_generation);
+                    }
+                    break;
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            switch(address) {
+                case _Base + 0: *dest = (REG8)(_source & 0xFF); break;
+                case _Base + 1: *dest = (REG8)(_source >> 8); break;
+                case _Base + 2: *dest = (REG8)(_destination & 0xFF); break;
+                case _Base + 3: *dest = (REG8)(_destination >> 8); break;
+                case _Base + 4: *dest = (REG8)(_length & 0xFF); break;
+                case _Base + 5: *dest = (REG8)(_length >> 8); break;
+                case _Base + 6: *dest = _mode; break;
+                case _Base + 7:
+                    if (_irq) {
+                        _bus->changed();
+                    }
+                    _irq = false;
+                    *dest = _status;
+                    break;
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return page == (_Base >> 8) || page == ((_Base + 7) >> 8);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,45 @@
+#include "hdd.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dave
+{
+
+disk_image::disk_image(const std::string &imagefn)
+: _data(nullptr), _size(0)
+{
+    // A missing image is a disk without sectors. A trailing partial sector is not used.
+    int fd = open(imagefn.c_str(), O_RDWR);
+    if (fd == -1) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sector_size) {
+        auto size = (size_t)st.st_size / sector_size * sector_size;
+        void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED) {
+            _data = (REG8*)p;
+            _size = size;
+        }
+    }
+    close(fd);
+}
+
+disk_image::~disk_image()
+{
+    if (_data != nullptr) {
+        munmap(_data, _size);
+    }
+}
+
+void disk_image::flush()
+{
+    if (_data != nullptr) {
+        msync(_data, _size, MS_SYNC);
+    }
+}
+
+}
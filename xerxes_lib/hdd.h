@@ -0,0 +1,215 @@
+#ifndef __HDDH
+#define __HDDH
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace dave
+{
+    // A disk image file of 256 byte sectors, memory mapped so the disk reads and writes the file directly
+    class disk_image {
+    private:
+        REG8 *_data;
+        size_t _size;
+    public:
+        static const size_t sector_size = 256;
+
+        explicit disk_image(const std::string &imagefn);
+        ~disk_image();
+
+        disk_image(const disk_image&) = delete;
+        disk_image(disk_image &&) = delete;
+        auto operator =(const disk_image&)->disk_image& = delete;
+        auto operator =(disk_image &&)->disk_image& = delete;
+
+        // 0 if the image could not be opened
+        auto sectors() const -> size_t { return _size / sector_size; }
+        auto sector(size_t sector) -> REG8* { return _data + sector * sector_size; }
+
+        void flush();
+    };
+
+    // Block storage. The cpu selects a sector and gives a command; the disk raises an IRQ once the command is done.
+    //   _Control   : command (see below)
+    //   _Status    : 0 = ready, 1 = busy, 2 = done, 0x80 = error
+    //   _Sector    : sector, lo byte (hi byte at _Sector + 1)
+    //   _Data      : data port, reads or writes the next byte of the sector buffer
+    //   _Memory    : memory address for DMA, lo byte (hi byte at _Memory + 1)
+    template<REG16 _Control, REG16 _Status, REG16 _Sector, REG16 _Data, REG16 _Memory> class hdd : public device {
+    public:
+        enum class command {
+            read = 0x01,        // sector to buffer
+            write = 0x02,       // buffer to sector
+            dma_read = 0x03,    // sector to memory
+            dma_write = 0x04,   // memory to sector
+            flush = 0x05        // write the image to the host disk
+        };
+        enum class status {
+            ready = 0x00,
+            busy = 0x01,
+            done = 0x02,
+            error = 0x80
+        };
+    private:
+        std::unique_ptr<disk_image> _image;
+
+        bool _irq;
+        bool _busy;
+        size_t _generation; // tags the scheduled completion
+        command _command;
+        REG8 _status;
+        REG16 _sector;
+        REG16 _memory;
+        REG8 _buffer[disk_image::sector_size];
+        REG8 _position;
+
+        // Between the sector and memory, a page at a time. Pages only plain memory backs are copied with memcpy,
+        // everything else goes through the bus.
+        void transfer(REG8 *sector, bool to_memory) {
+            size_t done = 0;
+            while(done < disk_image::sector_size) {
+                auto addr = (REG16)(_memory + done);
+                size_t chunk = std::min(disk_image::sector_size - done, (size_t)(0x100 - (addr & 0xFF)));
+                auto page = _bus->direct((REG8)(addr >> 8));
+                if (page != nullptr) {
+                    if (to_memory) {
+                        std::memcpy(page + (addr & 0xFF), sector + done, chunk);
+                    }
+                    else {
+                        std::memcpy(sector + done, page + (addr & 0xFF), chunk);
+                    }
+                }
+                else {
+                    for(size_t i = 0; i < chunk; i++) {
+                        if (to_memory) {
+                            _bus->write((REG16)(addr + i), &sector[done + i]);
+                        }
+                        else {
+                            _bus->read((REG16)(addr + i), &sector[done + i]);
+                        }
+                    }
+                }
+                done += chunk;
+            }
+        }
+
+        void complete() {
+            _status = (REG8)status::done;
+            auto s = _image->sector(_sector);
+            switch(_command) {
+                case command::read:
+                    std::memcpy(_buffer, s, sizeof(_buffer));
+                    break;
+                case command::write:
+                    std::memcpy(s, _buffer, sizeof(_buffer));
+                    break;
+                case command::dma_read:
+                    transfer(s, true);
+                    break;
+                case command::dma_write:
+                    transfer(s, false);
+                    break;
+                case command::flush:
+                    _image->flush();
+                    break;
+            }
+            _irq = true;
+        }
+    public:
+        hdd(system_bus *bus, debugger *debugger, std::unique_ptr<disk_image> image)
+            : device(bus, debugger), _image(std::move(image)), _irq(false), _busy(false), _generation(0), _command(command::read), _status(0), _sector(0), _memory(0), _buffer{}, _position(0)
+        {}
+        hdd(system_bus *bus, debugger *debugger, const std::string &imagefn)
+            : hdd(bus, debugger, std::make_unique<disk_image>(imagefn))
+        {}
+        hdd() = delete;
+        hdd(const hdd&) = delete;
+        hdd(hdd &&) = delete;
+        auto operator =(const hdd&)->hdd& = delete;
+        auto operator =(hdd &&)->hdd& = delete;
+
+        virtual bool irq() override { return _irq; }
+        virtual void event(size_t tag) override {
+            if (tag != _generation || !_busy) return;
+            _busy = false;
+            complete();
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            switch(address) {
+                case _Control:
+                    _irq = false;
+                    _position = 0;
+                    if (_busy || *data < (REG8)command::read || *data > (REG8)command::flush) {
+                        // Busy, or not a command
+                        _status = (REG8)status::error;
+                    }
+                    else if (_sector >= _image->sectors() && (command)*data != command::flush) {
+                        _status = (REG8)status::error;
+                    }
+                    else {
+                        _command = (command)*data;
+                        _status = (REG8)status::busy;
+                        // Seek and transfer time
+                        _busy = true;
+                        _bus->schedule(this, _bus->timing().delay(500, 999), ++_generation);
+                    }
+                    break;
+                case _Sector:
+                    _sector = (_sector & 0xFF00) | *data;
+                    break;
+                case _Sector + 1:
+                    _sector = (_sector & 0x00FF) | ((REG16)*data << 8);
+                    break;
+                case _Data:
+                    _buffer[_position++] = *data;
+                    break;
+                case _Memory:
+                    _memory = (_memory & 0xFF00) | *data;
+                    break;
+                case _Memory + 1:
+                    _memory = (_memory & 0x00FF) | ((REG16)*data << 8);
+                    break;
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            switch(address) {
+                case _Status:
+                    if (_irq) {
+                        _bus->changed();
+                    }
+                    _irq = false;
+                    *dest = _status;
+                    break;
+                case _Sector:
+                    *dest = (REG8)(_sector & 0xFF);
+                    break;
+                case _Sector + 1:
+                    *dest = (REG8)(_sector >> 8);
+                    break;
+                case _Data:
+                    _bus->changed();
+                    *dest = _buffer[_position++];
+                    break;
+                case _Memory:
+                    *dest = (REG8)(_memory & 0xFF);
+                    break;
+                case _Memory + 1:
+                    *dest = (REG8)(_memory >> 8);
+                    break;
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return page == (_Control >> 8) || page == (_Status >> 8) || page == (_Sector >> 8) || page == ((_Sector + 1) >> 8)
+                || page == (_Data >> 8) || page == (_Memory >> 8) || page == ((_Memory + 1) >> 8);
+        }
+    };
+}
+
+#endif
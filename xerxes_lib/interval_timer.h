@@ -0,0 +1,113 @@
+#ifndef __INTERVAL_TIMERH
+#define __INTERVAL_TIMERH
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+namespace dave
+{
+    // A programmable interval timer. It waits on the bus's event schedule, so it costs nothing while it counts.
+    // Registers, from _Base:
+    //   +0: reload (lo, hi at +1), the interval is reload << prescale bus cycles (a reload of 0 is 65536)
+    //   +2: control
+    //       bit 0  : enabled, writing the control with this set (re)starts the timer
+    //       bit 1  : periodic (else one-shot, the timer disables itself when it expires)
+    //       bit 2  : raise an NMI (else an IRQ)
+    //       bit 4-7: prescale
+    //   +3: status, bit 0 is set when the timer expired. Reading the status clears it, and the interupt line
+    //   +4: cycles until the timer expires, lo byte (hi at +5), divided by the prescale
+    template<REG16 _Base> class interval_timer : public device {
+    public:
+        static const REG8 enabled = 0x01;
+        static const REG8 periodic = 0x02;
+        static const REG8 use_nmi = 0x04;
+    private:
+        REG16 _reload;
+        REG8 _control;
+        bool _expired;
+        size_t _generation; // tags the scheduled expiry, so a restart ignores the pending one
+        size_t _due;
+
+        auto interval() const -> size_t {
+            return (_reload == 0 ? 0x10000 : (size_t)_reload) << (_control >> 4);
+        }
+        void start() {
+            _generation++;
+            _due = _bus->now() + interval();
+            _bus->schedule(this, interval(), _generation);
+        }
+        auto remaining() const -> size_t {
+            if ((_control & enabled) == 0 || _due <= _bus->now()) return 0;
+            return (_due - _bus->now()) >> (_control >> 4);
+        }
+    public:
+        interval_timer(system_bus *bus, debugger *debugger)
+            : device(bus, debugger), _reload(0), _control(0), _expired(false), _generation(0), _due(0)
+        {}
+        interval_timer() = delete;
+        interval_timer(const interval_timer&) = delete;
+        interval_timer(interval_timer &&) = delete;
+        auto operator =(const interval_timer&)->interval_timer& = delete;
+        auto operator =(interval_timer &&)->interval_timer& = delete;
+
+        virtual bool irq() override { return _expired && (_control & use_nmi) == 0; }
+        virtual bool nmi() override { return _expired && (_control & use_nmi) != 0; }
+        virtual void event(size_t tag) override {
+            if (tag != _generation || (_control & enabled) == 0) {
+                return;
+            }
+            _expired = true;
+            if (_control & periodic) {
+                // From the due cycle, so the period doesn't drift
+                _due += interval();
+                _bus->schedule(this, _due - _bus->now(), _generation);
+            }
+            else {
+                _control &= ~enabled;
+            }
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            switch(address) {
+                case _Base + 0:
+                    _reload = (_reload & 0xFF00) | *data;
+                    break;
+                case _Base + 1:
+                    _reload = (_reload & 0x00FF) | ((REG16)*data << 8);
+                    break;
+                case _Base + 2:
+                    _control = *data;
+                    if (_control & enabled) {
+                        start();
+                    }
+                    else {
+                        _generation++;
+                    }
+                    break;
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            switch(address) {
+                case _Base + 0: *dest = (REG8)(_reload & 0xFF); break;
+                case _Base + 1: *dest = (REG8)(_reload >> 8); break;
+                case _Base + 2: *dest = _control; break;
+                case _Base + 3:
+                    if (_expired) {
+                        _bus->changed();
+                    }
+                    *dest = _expired ? 0x01 : 0x00;
+                    _expired = false;
+                    break;
+                // The count goes down without an event, a loop reading it doesn't idle
+                case _Base + 4: _bus->changed(); *dest = (REG8)(remaining() & 0xFF); break;
+                case _Base + 5: _bus->changed(); *dest = (REG8)((remaining() >> 8) & 0xFF); break;
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return page == (_Base >> 8) || page == ((_Base + 5) >> 8);
+        }
+    };
+}
+
+#endif
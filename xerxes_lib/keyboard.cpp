@@ -0,0 +1,73 @@
+#include "keyboard.h"
+
+#include <chrono>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dave
+{
+
+key_feeder::key_feeder(key_queue &queue, int fd, int break_key)
+: _queue(queue), _fd(fd), _close(false), _break_key(break_key), _stop(false), _break_requested(false)
+{
+    _thread = std::thread(&key_feeder::feed, this);
+}
+
+key_feeder::key_feeder(key_queue &queue, const std::string &scriptfn)
+: _queue(queue), _fd(open(scriptfn.c_str(), O_RDONLY)), _close(true), _break_key(-1), _stop(false), _break_requested(false)
+{
+    if (_fd == -1) {
+        return;
+    }
+    // Read as much of the script as the queue holds, before the machine runs
+    while(_queue.size() < 4000 && read_some(false)) {}
+    _thread = std::thread(&key_feeder::feed, this);
+}
+
+key_feeder::~key_feeder()
+{
+    _stop = true;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    if (_close && _fd != -1) {
+        close(_fd);
+    }
+}
+
+bool key_feeder::read_some(bool wait)
+{
+    if (wait) {
+        // Wake up now and then to see if we must stop
+        pollfd p = { _fd, POLLIN, 0 };
+        if (poll(&p, 1, 50) <= 0) {
+            return true;
+        }
+    }
+    REG8 buf[64];
+    auto n = ::read(_fd, buf, sizeof(buf));
+    if (n <= 0) {
+        return false;
+    }
+    for(ssize_t i = 0; i < n; i++) {
+        if (buf[i] == _break_key) {
+            _break_requested = true;
+            continue;
+        }
+        while(!_queue.push(buf[i])) {
+            if (_stop) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return true;
+}
+
+void key_feeder::feed()
+{
+    while(!_stop && read_some(true)) {}
+}
+
+}
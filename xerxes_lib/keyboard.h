@@ -0,0 +1,154 @@
+#ifndef __KEYBOARDH
+#define __KEYBOARDH
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace dave
+{
+    // Keys on their way from the host to the keyboard. One thread pushes, one pops, without locks.
+    class key_queue {
+    private:
+        static const size_t capacity = 4096;
+        REG8 _keys[capacity];
+        std::atomic<size_t> _head; // the next key to pop
+        std::atomic<size_t> _tail; // where the next key goes
+    public:
+        key_queue() : _head(0), _tail(0) {}
+
+        key_queue(const key_queue&) = delete;
+        key_queue(key_queue &&) = delete;
+        auto operator =(const key_queue&)->key_queue& = delete;
+        auto operator =(key_queue &&)->key_queue& = delete;
+
+        // False if the queue is full
+        bool push(REG8 key) {
+            auto tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head.load(std::memory_order_acquire) == capacity) return false;
+            _keys[tail % capacity] = key;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+        // False if the queue is empty
+        bool pop(REG8 &key) {
+            auto head = _head.load(std::memory_order_relaxed);
+            if (head == _tail.load(std::memory_order_acquire)) return false;
+            key = _keys[head % capacity];
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+        auto size() const -> size_t {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+        }
+    };
+
+    // Reads keys from a file descriptor (a script file, or the terminal) on a host thread, and pushes them to a
+    // queue. A script file is read up front for as far as the queue holds it, so short scripts are deterministic.
+    // The break key, if any, is not pushed but sets break_requested.
+    class key_feeder {
+    private:
+        key_queue &_queue;
+        int _fd;
+        bool _close;
+        int _break_key;
+        std::atomic<bool> _stop;
+        std::atomic<bool> _break_requested;
+        std::thread _thread;
+
+        // False once the input ended
+        bool read_some(bool wait);
+        void feed();
+    public:
+        key_feeder(key_queue &queue, int fd, int break_key = -1);
+        key_feeder(key_queue &queue, const std::string &scriptfn);
+        ~key_feeder();
+
+        key_feeder(const key_feeder&) = delete;
+        key_feeder(key_feeder &&) = delete;
+        auto operator =(const key_feeder&)->key_feeder& = delete;
+        auto operator =(key_feeder &&)->key_feeder& = delete;
+
+        // False if the script could not be opened
+        auto is_open() const -> bool { return _fd != -1; }
+        // True once after the break key was pressed
+        bool break_requested() { return _break_requested.exchange(false); }
+    };
+
+    // The keyboard. It scans the queue every scan_cycles bus cycles (on the bus's event schedule), and once the
+    // program asked for it, raises an IRQ while keys are waiting. The IRQ is off at powerup: the ROM's interupt
+    // handler only knows the punch card reader, and keys typed while a deck loads would keep interupting it.
+    //   _Data  : reading pops the next key (0 if there is none), and clears the IRQ
+    //   _Status: read for the number of keys waiting (255 if more); write 01 to raise the IRQ, 00 to poll
+    template<REG16 _Data, REG16 _Status> class keyboard : public device {
+    public:
+        static const REG8 irq_on_key = 0x01;
+    private:
+        key_queue &_queue;
+        size_t _scan_cycles;
+        size_t _generation;
+        bool _irq;
+        REG8 _control;
+    public:
+        keyboard(system_bus *bus, debugger *debugger, key_queue *queue, size_t scan_cycles = 1000)
+            : device(bus, debugger), _queue(*queue), _scan_cycles(scan_cycles), _generation(0), _irq(false), _control(0)
+        {}
+        keyboard() = delete;
+        keyboard(const keyboard&) = delete;
+        keyboard(keyboard &&) = delete;
+        auto operator =(const keyboard&)->keyboard& = delete;
+        auto operator =(keyboard &&)->keyboard& = delete;
+
+        virtual bool irq() override { return _irq; }
+        virtual void powerup() override {
+            _irq = false;
+            _control = 0;
+            _bus->schedule(this, _scan_cycles, ++_generation);
+        }
+        virtual void event(size_t tag) override {
+            if (tag != _generation) return;
+            if ((_control & irq_on_key) && _queue.size() != 0) {
+                _irq = true;
+            }
+            _bus->schedule(this, _scan_cycles, _generation);
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            if (address == _Status) {
+                _control = *data;
+                if ((_control & irq_on_key) == 0) {
+                    _irq = false;
+                }
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            switch(address) {
+                case _Data: {
+                    bool popped = _queue.pop(*dest);
+                    if (popped || _irq) {
+                        _bus->changed();
+                    }
+                    _irq = false;
+                    if (!popped) {
+                        *dest = 0;
+                    }
+                    break;
+                }
+                case _Status: {
+                    auto size = _queue.size();
+                    *dest = size > 255 ? 255 : (REG8)size;
+                    break;
+                }
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return page == (_Data >> 8) || page == (_Status >> 8);
+        }
+    };
+}
+
+#endif
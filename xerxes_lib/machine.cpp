@@ -1,5 +1,6 @@
 #include "machine.h"
 
+#include <chrono>
 #include <thread>
 
 namespace dave
@@ -29,9 +30,17 @@ void machine::run()
     // We run at CLOCKS_PER_SEC (1 mil). We cannot measure this - it should be close enough
 
     while(!_bus.tick()) {
-        _debugger->tick();
+        _debugger->tick(_bus.round_cycles());
         // Carry on - but sleep so we have the correct speed
-        std::this_thread::yield();
+        if (_realtime) {
+            if (_bus.idled()) {
+                // The cpu idled (i.e. WAI) until the next event, give the host the time it skipped
+                std::this_thread::sleep_for(std::chrono::microseconds(_bus.round_cycles()));
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
         if (_debugger->break_asap()) {
             break;
         }
@@ -39,11 +48,54 @@ void machine::run()
     _debugger->tick();
 }
 
+void machine::realtime(bool value)
+{
+    _realtime = value;
+}
+
+void machine::quantum(size_t cycles)
+{
+    _bus.quantum(cycles);
+}
+
+void machine::parallel(bool value)
+{
+    _bus.parallel(value);
+}
+
+void machine::skip_idle(bool value)
+{
+    _bus.skip_idle(value);
+}
+
+void machine::profile(bool value)
+{
+    _bus.profile(value);
+}
+
+void machine::report_profile(std::ostream &stm, const std::vector<REG8> &io_pages, size_t top)
+{
+    auto p = _bus.profile();
+    if (p != nullptr) {
+        p->report(stm, _bus.now(), io_pages, top);
+    }
+}
+
 void machine::report_cpu_status()
 {
     _bus.report_cpu_status();
 }
 
+void machine::seed(uint32_t value)
+{
+    _bus.timing().seed(value);
+}
+
+void machine::fix_device_timing(size_t ticks)
+{
+    _bus.timing().fix(ticks);
+}
+
 void machine::reset(bool value)
 {
     _bus.reset = value;
@@ -2,6 +2,8 @@
 #define __MACHINEH
 
 #include <memory>
+#include <ostream>
+#include <vector>
 
 #include "system_bus.h"
 #include "cpu.h"
@@ -15,6 +17,7 @@ namespace dave
         bool _nmi_line = false;
         system_bus _bus;
         debugger *_debugger;
+        bool _realtime = true;
     public:
         machine(debugger *debugger);
 
@@ -23,8 +26,9 @@ namespace dave
         machine& operator =(const machine&) = delete;
         machine& operator =(machine &&) = delete;
 
-        template<typename TCpu> TCpu* install_cpu() {
-            return (TCpu*)_bus.attach_cpu(std::make_unique<TCpu>(&_bus, _debugger));
+        // The budget is the number of cpu cycles per bus cycle, i.e. a cpu with a budget of 2 runs at twice the clock
+        template<typename TCpu> TCpu* install_cpu(size_t budget = 1) {
+            return (TCpu*)_bus.attach_cpu(std::make_unique<TCpu>(&_bus, _debugger), budget);
         }
 
         template<typename TDevice, typename ... TArgs> TDevice* install_device(TArgs ... args) {
@@ -41,6 +45,24 @@ namespace dave
 
         void report_cpu_status();
 
+        // Device timing: seed the random delays, or fix them to a number of ticks (0 = random)
+        void seed(uint32_t value);
+        void fix_device_timing(size_t ticks);
+
+        // In realtime mode the machine yields the host thread every tick, and sleeps through the cycles the cpu idled
+        // (see system_bus::idled). Headless runs turn this off to run as fast as the host allows.
+        void realtime(bool value);
+
+        // The number of bus cycles every cpu runs before it yields the bus (1 = lockstep)
+        void quantum(size_t cycles);
+        // Run every cpu on its own host thread, see system_bus::parallel. Install the cpus first.
+        void parallel(bool value);
+        // Skip the cycles the cpu idles in a loop until the next device event, see system_bus::skip_idle
+        void skip_idle(bool value);
+        // Count the bus accesses per address from now on, see system_bus::profile, and report the heatmap
+        void profile(bool value);
+        void report_profile(std::ostream &stm, const std::vector<REG8> &io_pages, size_t top = 16);
+
         void powerup();
         void run();
     };
@@ -1 +1,200 @@
-#include "punchcardreader.h"
\ No newline at end of file
+#include "punchcardreader.h"
+
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dave
+{
+
+card_deck::~card_deck()
+{}
+
+bool try_decode_card_line(const char *begin, const char *end, card_line &line)
+{
+    // Holes after a ';' are notes on the card, and are ignored
+    size_t bits = 0;
+    line.first = 0;
+    line.second = 0;
+    for(const char *p = begin; p != end && *p != ';'; p++) {
+        REG8 bit;
+        if (*p == ' ' || *p == '\t') {
+            continue;
+        }
+        else if (*p == '_') {
+            bit = 0;
+        }
+        else if (*p == 'O') {
+            bit = 1;
+        }
+        else {
+            return false;
+        }
+        if (bits < 2) {
+            line.first = (line.first << 1) | bit;
+        }
+        else if (bits < 10) {
+            line.second = (line.second << 1) | bit;
+        }
+        bits++;
+    }
+    return bits == 10;
+}
+
+text_card_deck::text_card_deck(const std::string &datafn)
+: _next_line(0)
+{
+    std::ifstream stm(datafn);
+    _card.reserve(16);
+    std::string text;
+    card_line line;
+    while(std::getline(stm, text)) {
+        if (try_decode_card_line(text.data(), text.data() + text.size(), line)) {
+            _card.push_back(line);
+        }
+    }
+}
+
+void text_card_deck::rewind()
+{
+    _next_line = 0;
+}
+
+bool text_card_deck::next(card_line &line)
+{
+    if (_next_line == _card.size()) {
+        return false;
+    }
+    line = _card[_next_line];
+    _next_line++;
+    return true;
+}
+
+mapped_card_deck::mapped_card_deck(const std::string &datafn)
+: _begin(nullptr), _end(nullptr), _cursor(nullptr), _size(0), _cached(0), _next_cached(0)
+{
+    // A missing or empty file is an empty deck
+    int fd = open(datafn.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            _size = (size_t)st.st_size;
+            _begin = (const char*)p;
+            _end = _begin + _size;
+            // We read the deck front to back
+            madvise(p, _size, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);
+    _cursor = _begin;
+}
+
+mapped_card_deck::~mapped_card_deck()
+{
+    if (_begin != nullptr) {
+        munmap((void*)_begin, _size);
+    }
+}
+
+void mapped_card_deck::fill()
+{
+    _cached = 0;
+    _next_cached = 0;
+    while(_cached < sizeof(_cache) / sizeof(_cache[0]) && _cursor != _end) {
+        const char *eol = _cursor;
+        while(eol != _end && *eol != '\n') {
+            eol++;
+        }
+        if (try_decode_card_line(_cursor, eol, _cache[_cached])) {
+            _cached++;
+        }
+        _cursor = eol == _end ? eol : eol + 1;
+    }
+}
+
+void mapped_card_deck::rewind()
+{
+    _cursor = _begin;
+    _cached = 0;
+    _next_cached = 0;
+}
+
+bool mapped_card_deck::next(card_line &line)
+{
+    if (_next_cached == _cached) {
+        fill();
+        if (_cached == 0) {
+            return false;
+        }
+    }
+    line = _cache[_next_cached];
+    _next_cached++;
+    return true;
+}
+
+binary_card_deck::binary_card_deck(const std::string &datafn)
+: _lines(0), _next_line(0)
+{
+    std::ifstream stm(datafn, std::ios::in | std::ios::binary);
+    REG8 header[8] = {};
+    if (!stm.read((char*)header, sizeof(header))) {
+        return;
+    }
+    size_t lines = 0;
+    for(size_t i = 0; i < 4; i++) {
+        lines |= (size_t)header[4 + i] << (i * 8);
+    }
+    // The header isn't trusted: a deck that claims more lines than the file holds is rejected (an empty deck)
+    stm.seekg(0, std::ios::end);
+    auto size = (size_t)stm.tellg() - sizeof(header);
+    if ((lines * 10 + 7) / 8 > size) {
+        return;
+    }
+    _packed.resize((lines * 10 + 7) / 8);
+    stm.seekg(sizeof(header), std::ios::beg);
+    if (stm.read((char*)_packed.data(), _packed.size())) {
+        _lines = lines;
+    }
+}
+
+void binary_card_deck::rewind()
+{
+    _next_line = 0;
+}
+
+bool binary_card_deck::next(card_line &line)
+{
+    if (_next_line == _lines) {
+        return false;
+    }
+    // The 10 bits of a line span two bytes
+    size_t bit = _next_line * 10;
+    unsigned int word = ((unsigned int)_packed[bit / 8] << 8) | (bit / 8 + 1 < _packed.size() ? _packed[bit / 8 + 1] : 0);
+    word = (word >> (6 - bit % 8)) & 0x03FF;
+    line.first = (REG8)(word >> 8);
+    line.second = (REG8)word;
+    _next_line++;
+    return true;
+}
+
+auto open_card_deck(const std::string &datafn, bool streaming) -> std::unique_ptr<card_deck>
+{
+    char magic[4] = {};
+    std::ifstream(datafn, std::ios::in | std::ios::binary).read(magic, sizeof(magic));
+    if (magic[0] == 'X' && magic[1] == 'P' && magic[2] == 'C' && magic[3] == 'B') {
+        return std::make_unique<binary_card_deck>(datafn);
+    }
+    if (streaming) {
+        return std::make_unique<mapped_card_deck>(datafn);
+    }
+    return std::make_unique<text_card_deck>(datafn);
+}
+
+}
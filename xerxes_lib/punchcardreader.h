@@ -5,11 +5,83 @@
 #include "device.h"
 #include "system_bus.h"
 
-#include <fstream>
-#include <random>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace dave
 {
+    // The lines of a punch card: (instruction, data)
+    typedef std::pair<REG8, REG8> card_line;
+
+    // A deck of punch cards, read one line at a time
+    class card_deck {
+    public:
+        card_deck() = default;
+        card_deck(const card_deck&) = delete;
+        card_deck(card_deck &&) = delete;
+        virtual ~card_deck();
+        auto operator =(const card_deck&)->card_deck& = delete;
+        auto operator =(card_deck &&)->card_deck& = delete;
+
+        virtual void rewind() = 0;
+        virtual bool next(card_line &line) = 0;
+    };
+
+    // Decodes the whole text file up front
+    class text_card_deck : public card_deck {
+    private:
+        std::vector<card_line> _card;
+        size_t _next_line;
+    public:
+        explicit text_card_deck(const std::string &datafn);
+
+        virtual void rewind() override;
+        virtual bool next(card_line &line) override;
+    };
+
+    // Memory maps the text file, and decodes the lines in small batches as they are requested
+    class mapped_card_deck : public card_deck {
+    private:
+        const char *_begin;
+        const char *_end;
+        const char *_cursor;
+        size_t _size;
+        card_line _cache[64];
+        size_t _cached;
+        size_t _next_cached;
+
+        void fill();
+    public:
+        explicit mapped_card_deck(const std::string &datafn);
+        virtual ~mapped_card_deck();
+
+        virtual void rewind() override;
+        virtual bool next(card_line &line) override;
+    };
+
+    // A packed binary deck, as written by the intern's 'punchcard-binary' format: "XPCB", the number of
+    // lines (4 bytes, lo byte first), then 10 bits per line (2 instruction bits, 8 data bits), high bit first
+    class binary_card_deck : public card_deck {
+    private:
+        std::vector<REG8> _packed;
+        size_t _lines;
+        size_t _next_line;
+    public:
+        explicit binary_card_deck(const std::string &datafn);
+
+        virtual void rewind() override;
+        virtual bool next(card_line &line) override;
+    };
+
+    // Decode a line of text, i.e. "_ O  _ O _ _  O _ O O ; comment"
+    bool try_decode_card_line(const char *begin, const char *end, card_line &line);
+
+    // Binary decks are recognised by their header, anything else is read as text
+    auto open_card_deck(const std::string &datafn, bool streaming) -> std::unique_ptr<card_deck>;
+
     template<REG16 _Control, REG16 _Status, REG16 _Register> class punchcardreader : public device {
     public:
         enum class instruction {
@@ -21,58 +93,97 @@ namespace dave
         };
     private:
         bool _irq;
-        size_t _ticks_to_interupt;
-        
+        bool _requested;    // the next line was requested, the interupt is scheduled
+        size_t _generation; // tags the scheduled interupt, so a new request ignores the pending one
+
         REG8 _status;
         REG8 _register;
 
-        size_t _next_line;
-        std::vector<std::pair<REG8, REG8> > _card;
-    public:
-        punchcardreader(system_bus *bus, debugger *debugger, const std::string &datafn)
-            : device(bus, debugger), _status(0), _ticks_to_interupt(0), _irq(false), _next_line(0)
-        {
-            // Read the file
-            std::ifstream stm(datafn);
-            _card.reserve(16);
-            while(!stm.eof()) {
-                char line[1024];
-                stm.getline(line, 1023);
-                line[strcspn(line, ";")] = 0;
-                std::vector<bool> bytes;
-                const char *p = line;
-                while(*p != 0) {
-                    if (*p == ' ' || *p == '\t') {
-                        p++;
-                    }
-                    else if (*p == '_') {
-                        bytes.push_back(false);
-                        p++;
-                    }
-                    else if (*p == 'O') {
-                        bytes.push_back(true);
-                        p++;
-                    }
-                    else {
-                        bytes.clear();
-                        break;
-                    }
-                }
-                if (bytes.size() == 10) {
-                    _card.emplace_back(0, 0);
-                    for(size_t i = 0; i < 2; i++) {
-                        _card.back().first <<= 1;
-                        _card.back().first |= (bytes[i] ? 1 : 0);
+        std::unique_ptr<card_deck> _deck;
+
+        // In DMA mode the data lines are written straight to memory, all but the last one. The driver's
+        // pointer and index are left as it would have them, and the last data line and the lines after it
+        // (the start address) go through the IRQ handshake, so the driver ends with the same registers.
+        bool _dma;
+        std::deque<card_line> _pending;
+        REG16 _addr;
+        REG8 _index;
+
+        // Follow the address the ROM driver would write the next data byte to
+        void track(const card_line &line) {
+            switch((instruction)line.first) {
+                case instruction::read_data:
+                    _index++;
+                    break;
+                case instruction::read_lo_addr:
+                    _addr = (_addr & 0xFF00) | line.second;
+                    break;
+                case instruction::read_hi_addr:
+                    _addr = (_addr & 0x00FF) | ((REG16)line.second << 8);
+                    _index = 0;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Where the ROM driver (software/romv2.asm) keeps the index and the pointer it writes data to
+        static const REG16 driver_index = 0x03;
+        static const REG16 driver_addr = 0x0E;
+
+        void transfer() {
+            card_line line;
+            bool held = false;
+            while(_deck->next(line)) {
+                if (line.first == (REG8)instruction::read_data) {
+                    if (held) {
+                        // The driver stores at [addr] + Y, with Y an 8-bit index
+                        _bus->write(_addr + _index, &_pending.front().second);
+                        track(_pending.front());
                     }
-                    for(size_t i = 2; i < 10; i++) {
-                        _card.back().second <<= 1;
-                        _card.back().second |= (bytes[i] ? 1 : 0);
+                    // The lines before this one only move the address
+                    for(auto &p : _pending) {
+                        if (p.first != (REG8)instruction::read_data) track(p);
                     }
+                    _pending.clear();
+                    held = true;
                 }
+                _pending.push_back(line);
             }
-            _status = _card.empty() ? (REG8)instruction::no_instruction : _card[0].first;
-            _register = _card.empty() ? 0 : _card[0].second;
+            if (held) {
+                REG8 lo = (REG8)_addr, hi = (REG8)(_addr >> 8);
+                _bus->write(REG16(driver_index), &_index);
+                _bus->write(REG16(driver_addr), &lo);
+                _bus->write(REG16(driver_addr + 1), &hi);
+            }
+        }
+
+        void request(size_t delay) {
+            _requested = true;
+            _bus->schedule(this, delay, ++_generation);
+        }
+
+        bool next_line(card_line &line) {
+            if (_pending.empty()) {
+                return _deck->next(line);
+            }
+            line = _pending.front();
+            _pending.pop_front();
+            return true;
         }
+    public:
+        punchcardreader(system_bus *bus, debugger *debugger, std::unique_ptr<card_deck> deck, bool dma = false)
+            : device(bus, debugger), _status(0), _irq(false), _requested(false), _generation(0), _deck(std::move(deck)), _dma(dma), _addr(0), _index(0)
+        {
+            card_line line(0, 0);
+            _deck->next(line);
+            _deck->rewind();
+            _status = line.first;
+            _register = line.second;
+        }
+        punchcardreader(system_bus *bus, debugger *debugger, const std::string &datafn, bool dma = false)
+            : punchcardreader(bus, debugger, open_card_deck(datafn, false), dma)
+        {}
         punchcardreader() = delete;
         punchcardreader(const punchcardreader&) = delete;
         punchcardreader(punchcardreader &&) = delete;
@@ -80,15 +191,12 @@ namespace dave
         auto operator =(punchcardreader &&)->punchcardreader& = delete;
 
         virtual bool irq() override { return _irq; }
-        virtual void tick() override {
-            if (_ticks_to_interupt > 0) {
-                _ticks_to_interupt--;
-                if (_ticks_to_interupt == 0) {
-                    // Interupt
-                    _irq = true;
-                }
-            }
-            _debugger->report_punchcardreader_status(_irq, _ticks_to_interupt > 0, _status, _register);
+        virtual void event(size_t tag) override {
+            if (tag != _generation || !_requested) return;
+            // Interupt
+            _requested = false;
+            _irq = true;
+            _debugger->report_punchcardreader_status(_irq, _requested, _status, _register);
         }
         virtual void nop() override { }
         virtual void write(const REG16 &address, const REG8 *data) override {
@@ -97,25 +205,37 @@ namespace dave
                 _status = 0;
                 switch(*data) {
                     case 0x01: // Initialise
-                        _next_line = 0;
+                        _deck->rewind();
+                        _pending.clear();
+                        _addr = 0;
+                        _index = 0;
                         break;
-                    case 0x02: // Request next instruction
-                        if (_next_line == _card.size()) {
+                    case 0x02: { // Request next instruction
+                        if (_dma) {
+                            transfer();
+                        }
+                        card_line line;
+                        if (!next_line(line)) {
                             _status = (REG8)instruction::run_program;
-                            _ticks_to_interupt = (rand() % 300) + 200;
                         }
                         else {
-                            _register = _card[_next_line].second;
-                            _status = _card[_next_line].first;
-                            _next_line++;
-                            _ticks_to_interupt = (rand() % 300) + 200;
+                            _register = line.second;
+                            _status = line.first;
+                            track(line);
                         }
+                        request(_bus->timing().delay(200, 499));
                         break;
+                    }
                 }
-                _debugger->report_punchcardreader_status(_irq, _ticks_to_interupt > 0, _status, _register);
+                _debugger->report_punchcardreader_status(_irq, _requested, _status, _register);
             }
         }
         virtual void read(const REG16 &address, REG8 *dest) override {
+            if ((address == _Status || address == _Register) && (_irq || _status != 0)) {
+                // Reading clears the interupt and the status
+                _bus->changed();
+                _debugger->report_punchcardreader_status(false, _requested, 0, _register);
+            }
             switch(address) {
                 case _Status:
                     _irq = false;
@@ -129,6 +249,9 @@ namespace dave
                     break;
             } 
         }
+        virtual bool decodes(REG8 page) override {
+            return page == (_Control >> 8) || page == (_Status >> 8) || page == (_Register >> 8);
+        }
     };
 }
 
@@ -31,6 +31,15 @@ namespace dave
                 *dest = _data[address - addr_lower];
             }
         }
+        virtual bool decodes(REG8 page) override {
+            return page >= (addr_lower >> 8) && page <= (addr_upper >> 8);
+        }
+        virtual REG8* direct(REG8 page) override {
+            // Only whole pages
+            REG16 lower = (REG16)page << 8;
+            if (lower < addr_lower || lower + 0xFF > addr_upper) return nullptr;
+            return &_data[lower - addr_lower];
+        }
     };
 }
 
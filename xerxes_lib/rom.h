@@ -1,6 +1,9 @@
 #ifndef __ROMH
 #define __ROMH
 
+#include <fstream>
+#include <string>
+
 #include "common.h"
 #include "device.h"
 #include "system_bus.h"
@@ -29,12 +32,34 @@ namespace dave
                 *dest = _data[address - addr_lower];
             }
         }
+        virtual bool decodes(REG8 page) override {
+            return page >= (addr_lower >> 8) && page <= (addr_upper >> 8);
+        }
         void program(const REG16 &address, const REG8 &data) {
             if (address >= addr_lower && address <= addr_upper) {
                 _data[address - addr_lower] = data;
             }
         }
+        // Load a binary image, as written by the intern's 'image' format: "XROM", the address of the first byte
+        // (lo byte first), then the bytes. The image must fit in the ROM's window; the rest of the ROM stays as is.
+        bool load(const std::string &imagefn) {
+            std::ifstream stm(imagefn, std::ios::in | std::ios::binary);
+            REG8 header[6] = {};
+            if (!stm.read((char*)header, sizeof(header))
+                || header[0] != 'X' || header[1] != 'R' || header[2] != 'O' || header[3] != 'M') {
+                return false;
+            }
+            size_t base = header[4] | ((size_t)header[5] << 8);
+            stm.seekg(0, std::ios::end);
+            auto size = (size_t)stm.tellg() - sizeof(header);
+            if (base < addr_lower || base + size > (size_t)addr_upper + 1) {
+                return false;
+            }
+            stm.seekg(sizeof(header), std::ios::beg);
+            stm.read((char*)&_data[base - addr_lower], size);
+            return (size_t)stm.gcount() == size;
+        }
     };
 }
 
-#endif
\ No newline at end of file
+#endif
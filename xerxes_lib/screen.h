@@ -0,0 +1,74 @@
+#ifndef __SCREENH
+#define __SCREENH
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+namespace dave
+{
+    // The screen buffer of the monitor, 40 columns a row, without a terminal. It keeps track of the rows written
+    // since the last clean(), and can be copied or rendered as text at any time.
+    template<REG16 addr_lower, REG16 addr_upper> class screen : public device {
+    public:
+        static const size_t columns = 40;
+        static const size_t size = addr_upper - addr_lower + 1;
+        static const size_t rows = (size + columns - 1) / columns;
+        static_assert(rows <= 32, "The dirty rows must fit in 32 bits");
+    protected:
+        REG8 _data[size] = {};
+        uint32_t _dirty = 0;
+    public:
+        screen(system_bus *bus, debugger *debugger)
+            : device(bus, debugger)
+        {}
+        screen() = delete;
+        screen(const screen&) = delete;
+        screen(screen &&) = delete;
+        auto operator =(const screen&)->screen& = delete;
+        auto operator =(screen &&)->screen& = delete;
+
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            if (address >= addr_lower && address <= addr_upper) {
+                _data[address - addr_lower] = *data;
+                _dirty |= 1u << ((address - addr_lower) / columns);
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            if (address >= addr_lower && address <= addr_upper) {
+                *dest = _data[address - addr_lower];
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return page >= (addr_lower >> 8) && page <= (addr_upper >> 8);
+        }
+
+        // Bit n is set if row n was written since the last clean()
+        auto dirty_rows() const -> uint32_t { return _dirty; }
+        void clean() { _dirty = 0; }
+
+        // Copy the screen buffer (size bytes)
+        void snapshot(REG8 *dest) const { std::memcpy(dest, _data, size); }
+
+        // A line of text per row; characters that can't be printed show as '.'
+        auto text() const -> std::string {
+            std::string result;
+            result.reserve(rows * (columns + 1));
+            for(size_t i = 0; i < size; i++) {
+                auto ch = _data[i];
+                result.push_back(ch >= 0x20 && ch < 0x7F ? (char)ch : (ch == 0 ? ' ' : '.'));
+                if (i % columns == columns - 1 || i == size - 1) {
+                    result.push_back('\n');
+                }
+            }
+            return result;
+        }
+    };
+}
+
+#endif
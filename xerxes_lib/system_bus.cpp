@@ -1,8 +1,44 @@
 #include "system_bus.h"
 
+#include <algorithm>
+#include <cstdint>
+
 namespace dave
 {
+    // The cpu the current host thread runs in a parallel round
+    static thread_local size_t running_cpu = 0;
+
+    static size_t gcd(size_t a, size_t b)
+    {
+        while (b != 0) {
+            auto t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
     bool system_bus::irq()
+    {
+        if (!_threads) return irq_lines();
+        if (_irq_latched) return true;
+        for(auto &l : _device_lines) {
+            if (l.irq.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    bool system_bus::nmi()
+    {
+        if (!_threads) return nmi_lines();
+        if (_nmi_latched) return true;
+        for(auto &l : _device_lines) {
+            if (l.nmi.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    bool system_bus::irq_lines()
     {
         if (_irq_line) return true;
         for(auto &d : _devices) {
@@ -11,7 +47,7 @@ namespace dave
         return false;
     }
 
-    bool system_bus::nmi()
+    bool system_bus::nmi_lines()
     {
         if (_nmi_line) return true;
         for(auto &d : _devices) {
@@ -22,27 +58,193 @@ namespace dave
 
     bool system_bus::tick()
     {
+        if (_threads) {
+            return parallel_tick();
+        }
         _break_addr_written = false;
+        _idled = false;
+        if (_next_cpu == 0 && _skip_idle && !_profile) {
+            auto idle = idle_cycles();
+            if (idle != 0) {
+                _idled = true;
+                // Nothing happens until the next event; the cpu would only go round its loop
+                _round_cycles = idle;
+                tick_devices(idle);
+                return false;
+            }
+        }
+        _round_cycles = _quantum;
+        if (_next_cpu == 0) {
+            // Start a new round
+            tick_devices(_quantum);
+            for (auto &c : _cpus) {
+                c.remaining = c.budget * _quantum;
+            }
+        }
         bool must_break = false;
-        for (auto &d : _devices) {
-            d->tick();
+        while (_next_cpu < _cpus.size()) {
+            auto &c = _cpus[_next_cpu];
+            must_break = c.cpu->run(c.remaining);
+            if (c.remaining == 0) {
+                _next_cpu++;
+            }
+            if (must_break || _break_addr_written) {
+                break;
+            }
+        }
+        if (_next_cpu == _cpus.size()) {
+            _next_cpu = 0;
+        }
+        return must_break || _break_addr_written;
+    }
+
+    void system_bus::tick_devices(size_t cycles)
+    {
+        // The devices only act on their events, so the cycles in between pass at once
+        auto until = _now + cycles;
+        while (!_events.empty() && _events.top().at <= until) {
+            auto e = _events.top();
+            _events.pop();
+            _now = e.at;
+            _changes++;
+            e.target->event(e.tag);
+        }
+        _now = until;
+    }
+
+    size_t system_bus::idle_cycles()
+    {
+        if (_cpus.size() != 1) return 0;
+        auto &c = _cpus.front();
+        size_t period = c.cpu->idle_period();
+        if (period == 0) return 0;
+
+        // The cpu runs the cycles of a round after the devices ticked for it, so an event due at 'at' changes what the
+        // cpu sees from round at - now on. Skip the rounds before it, in whole turns of the loop, and whole quanta.
+        size_t horizon = _debugger->idle_cycles_allowed();
+        if (!_events.empty()) {
+            horizon = std::min(horizon, _events.top().at - _now - 1);
+        }
+        if (horizon == SIZE_MAX) return 0; // Nothing will ever change, don't run off with the clock
+        // Whole turns of the loop (in cpu cycles) that are also whole rounds (in bus cycles)
+        size_t round = c.budget * _quantum;
+        size_t step = round / gcd(round, period) * period / c.budget;
+        return horizon / step * step;
+    }
+
+    void system_bus::schedule(device *target, size_t cycles, size_t tag)
+    {
+        _events.push(scheduled_event { _now + (cycles == 0 ? 1 : cycles), _event_sequence++, target, tag });
+    }
+
+    bool system_bus::parallel_tick()
+    {
+        _break_addr_written = false;
+        _irq_latched = _irq_line;
+        _nmi_latched = _nmi_line;
+        for (size_t i = 0; i < _devices.size(); i++) {
+            latch_lines(i);
+        }
+        _pages.begin_round();
+        auto quantum = std::max(_quantum, (size_t)parallel_quantum);
+        for (auto &c : _cpus) {
+            c.remaining = c.budget * quantum;
         }
+        std::atomic<bool> must_break(false);
+        _threads->run([&](size_t i) {
+            running_cpu = i;
+            auto &c = _cpus[i];
+            if (c.cpu->run(c.remaining)) {
+                must_break = true;
+                _pages.interrupt();
+            }
+        });
+
+        // The round lasted as long as the cpu that got furthest
+        size_t cycles = 0;
         for (auto &c : _cpus) {
-            must_break |= c->tick();
+            cycles = std::max(cycles, (c.budget * quantum - c.remaining + c.budget - 1) / c.budget);
         }
+        _round_cycles = std::max(cycles, (size_t)1);
+        tick_devices(_round_cycles);
         return must_break || _break_addr_written;
     }
 
-    dave::cpu* system_bus::attach_cpu(std::unique_ptr<cpu> &&cpu)
+    void system_bus::latch_lines(size_t device)
     {
-        _cpus.push_back(std::move(cpu));
-        return _cpus.back().get();
+        auto &d = _devices[device];
+        _device_lines[device].irq.store(d->irq(), std::memory_order_relaxed);
+        _device_lines[device].nmi.store(d->nmi(), std::memory_order_relaxed);
+    }
+
+    void system_bus::relatch_lines(REG8 page)
+    {
+        // Reading or writing a device can raise or clear its lines, e.g. the driver reads the status to clear the
+        // interupt. Plain memory has no lines.
+        if (direct(page) != nullptr) return;
+        for (size_t i = 0; i < _devices.size(); i++) {
+            if (_devices[i]->decodes(page)) latch_lines(i);
+        }
+    }
+
+    void system_bus::parallel_write(const REG16 &address, const REG8 *data)
+    {
+        _pages.access(running_cpu, address, [&]() {
+            broadcast_write(address, data);
+            relatch_lines((REG8)(address >> 8));
+        });
+    }
+
+    void system_bus::parallel_read(const REG16 &address, REG8 *dest)
+    {
+        _pages.access(running_cpu, address, [&]() {
+            broadcast_read(address, dest);
+            relatch_lines((REG8)(address >> 8));
+        });
+    }
+
+    void system_bus::parallel(bool value)
+    {
+        _threads.reset();
+        if (value) {
+            _pages.resize(_cpus.size());
+            _threads = std::make_unique<cpu_threads>(_cpus.size());
+            _device_lines = std::vector<device_lines>(_devices.size());
+            for (size_t i = 0; i < _devices.size(); i++) {
+                latch_lines(i);
+            }
+        }
+    }
+
+    dave::cpu* system_bus::attach_cpu(std::unique_ptr<cpu> &&cpu, size_t budget)
+    {
+        _cpus.push_back(cpu_slot { std::move(cpu), budget == 0 ? 1 : budget, 0 });
+        return _cpus.back().cpu.get();
     }
 
     dave::device* system_bus::attach_device(std::unique_ptr<device> &&device)
     {
         _devices.push_back(std::move(device));
-        return _devices.back().get();
+        auto d = _devices.back().get();
+        for (size_t page = 0; page < 256; page++) {
+            bool first = true;
+            for (auto &o : _devices) {
+                if (o.get() != d && o->decodes((REG8)page)) {
+                    first = false;
+                    break;
+                }
+            }
+            if (d->decodes((REG8)page)) {
+                _page_device[page] = first ? d : nullptr;
+            }
+        }
+        if (_threads) {
+            _device_lines = std::vector<device_lines>(_devices.size());
+            for (size_t i = 0; i < _devices.size(); i++) {
+                latch_lines(i);
+            }
+        }
+        return d;
     }
 
     void system_bus::powerup()
@@ -50,15 +252,16 @@ namespace dave
         for(auto &d : _devices) {
             d->powerup();
         }
+        _next_cpu = 0;
         for(auto &c : _cpus) {
-            c->powerup();
+            c.cpu->powerup();
         }
     }
 
     void system_bus::report_cpu_status()
     {
         for(auto &c : _cpus) {
-            c->report_status();
+            c.cpu->report_status();
         }
     }
 }
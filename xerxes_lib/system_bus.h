@@ -1,6 +1,9 @@
 #ifndef __SYSTEMBUSH
 #define __SYSTEMBUSH
 
+#include <atomic>
+#include <functional>
+#include <queue>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -8,6 +11,10 @@
 #include "device.h"
 #include "cpu.h"
 #include "debugger.h"
+#include "timing.h"
+#include "bus_pages.h"
+#include "bus_profile.h"
+#include "cpu_threads.h"
 
 namespace dave
 {
@@ -18,12 +25,78 @@ namespace dave
         bool &_irq_line;
         bool &_nmi_line;
         debugger *_debugger;
-        std::vector<std::unique_ptr<cpu>> _cpus;
+        struct cpu_slot {
+            std::unique_ptr<dave::cpu> cpu;
+            size_t budget;    // cycles per bus cycle
+            size_t remaining; // cycles left in the current round
+        };
+        std::vector<cpu_slot> _cpus;
+        size_t _quantum = 1;  // bus cycles per round
+        size_t _next_cpu = 0; // the cpu to continue with in the current round
+        size_t _round_cycles = 1;
         std::vector<std::unique_ptr<device>> _devices;
-        bool _break_addr_written;
+        device *_page_device[256] = {}; // the only device that decodes the page, if there is one
+
+        // Device events, in the order they are due (and were scheduled, for events due in the same cycle)
+        struct scheduled_event {
+            size_t at;
+            size_t sequence;
+            device *target;
+            size_t tag;
+            bool operator >(const scheduled_event &other) const {
+                return at != other.at ? at > other.at : sequence > other.sequence;
+            }
+        };
+        std::priority_queue<scheduled_event, std::vector<scheduled_event>, std::greater<scheduled_event>> _events;
+        size_t _event_sequence = 0;
+        size_t _now = 0; // bus cycles since the machine was created
+        size_t _changes = 0;
+        bool _skip_idle = true;
+        bool _idled = false; // the last tick skipped the cycles the cpu idled
+        std::unique_ptr<bus_profile> _profile;
+        std::atomic<bool> _break_addr_written;
+        device_timing _timing;
+
+        // Parallel mode
+        std::unique_ptr<cpu_threads> _threads;
+        bus_pages _pages;
+        bool _irq_latched = false; // the machine's own lines, at the start of the round
+        bool _nmi_latched = false;
+        // Every device's lines, latched at the start of the round, and again whenever a cpu accessed a page of the
+        // device that isn't plain memory (the cpu then owns the page, or the access is serialised)
+        struct device_lines {
+            std::atomic<bool> irq;
+            std::atomic<bool> nmi;
+        };
+        std::vector<device_lines> _device_lines;
+
+        void tick_devices(size_t cycles);
+        auto idle_cycles() -> size_t;
+        bool irq_lines();
+        bool nmi_lines();
+        bool parallel_tick();
+        void latch_lines(size_t device);
+        void relatch_lines(REG8 page);
+        void parallel_write(const REG16 &address, const REG8 *data);
+        void parallel_read(const REG16 &address, REG8 *dest);
+        void broadcast_write(const REG16 &address, const REG8 *data) {
+            if (!_threads) _changes++;
+            _debugger->report_address_write(address, data);
+            for (auto &d : _devices) {
+                d->write(address, data);
+            }
+            if (_debugger->break_on_bus_address_changed(address)) {
+                _break_addr_written.store(true, std::memory_order_relaxed);
+            }
+        }
+        void broadcast_read(const REG16 &address, REG8 *dest) {
+            for (auto &d : _devices) {
+                d->read(address, dest);
+            }
+        }
     public:
         system_bus(debugger *debugger, bool &irq_line, bool &nmi_line)
-        : _debugger(debugger), _irq_line(irq_line), _nmi_line(nmi_line)
+        : _debugger(debugger), _irq_line(irq_line), _nmi_line(nmi_line), _break_addr_written(false), reset(false)
         {}
 
         system_bus(const system_bus&) = delete;
@@ -35,7 +108,48 @@ namespace dave
         bool nmi();
         bool reset;
 
+        // Run a round: the devices tick for the quantum, then every cpu, in the order they were attached, runs its
+        // budget for the quantum. With a quantum of 1 the cpus run in lockstep with the devices. Larger quanta let
+        // every cpu run a block of instructions before it yields the bus, which is much faster, but the cpus (and
+        // interupts) then only see each other's writes at quantum boundaries. Returns true if a cpu must break; the
+        // next tick continues the round where it broke off.
         bool tick();
+        void quantum(size_t cycles) { _quantum = cycles == 0 ? 1 : cycles; }
+        auto quantum() const -> size_t { return _quantum; }
+        // The number of bus cycles the last tick ran
+        auto round_cycles() const -> size_t { return _round_cycles; }
+
+        // The bus cycle the devices last ticked for
+        auto now() const -> size_t { return _now; }
+        // Call the device's event() with the tag once this many bus cycles have passed (at least 1). The devices
+        // only act on their events, and on the cpu's reads and writes. Events can't be cancelled; give them a tag
+        // to tell the stale ones apart.
+        void schedule(device *target, size_t cycles, size_t tag = 0);
+
+        // Counts the writes, the device events, and the reads that changed a device. While it stands still, memory
+        // and the devices are as they were. A device calls changed() when a read changes it, or when what it reads
+        // depends on the time. The cpu threads of a parallel run don't count, nothing skips idle cycles there.
+        auto changes() const -> size_t { return _changes; }
+        void changed() { if (!_threads) _changes++; }
+        // When the (single) cpu idles in a loop that repeats exactly until something changes (see cpu::idle_period),
+        // the bus skips whole turns of the loop, up to the cycle before the next event, in a single round. The debugger
+        // sees the skipped cycles as one tick. On by default.
+        void skip_idle(bool value) { _skip_idle = value; }
+        // Whether the last tick was such a skip (i.e. the cpu waited for an interupt), rather than a round the cpu ran
+        auto idled() const -> bool { return _idled; }
+
+        // In parallel mode every cpu runs its round on its own host thread. The pages a cpu has to itself are accessed
+        // without synchronisation; once two cpus touch the same page the accesses are serialised and the round ends at
+        // the next instruction (see bus_pages). The devices tick between rounds, for the cycles the round ran. The cpus
+        // see the interupt lines latched at the start of the round, or after their last access to the device, so
+        // reading a status clears the interupt at once. Runs are no longer deterministic, and the debugger must
+        // be safe to call from several threads. Set before powerup. A parallel round runs at least parallel_quantum
+        // cycles, whatever the quantum: handing a round to the threads costs far more than running a few cycles.
+        static const size_t parallel_quantum = 256;
+        void parallel(bool value);
+        auto parallel() const -> bool { return (bool)_threads; }
+        // True when a cpu should stop at its next instruction, to end a parallel round early
+        auto must_yield() const -> bool { return _pages.interrupted(); }
 
         void nop() {
             for (auto &d : _devices) {
@@ -43,23 +157,53 @@ namespace dave
             }
         }
         void write(const REG16 &address, const REG8 *data) {
-            _debugger->report_address_write(address, data);
-            for (auto &d : _devices) {
-                d->write(address, data);
+            if (_threads) {
+                parallel_write(address, data);
+            }
+            else {
+                if (_profile) _profile->writes[address]++;
+                broadcast_write(address, data);
             }
-            _break_addr_written = _debugger->break_on_bus_address_changed(address);
         }
         void read(const REG16 &address, REG8 *dest) {
-            for (auto &d : _devices) {
-                d->read(address, dest);
+            if (_threads) {
+                parallel_read(address, dest);
+            }
+            else {
+                if (_profile) _profile->reads[address]++;
+                broadcast_read(address, dest);
             }
         }
+        // The cpu reads the opcode of its next instruction. Only the profile tells it apart from a read.
+        void fetch(const REG16 &address, REG8 *dest) {
+            if (_threads) {
+                parallel_read(address, dest);
+            }
+            else {
+                if (_profile) _profile->fetches[address]++;
+                broadcast_read(address, dest);
+            }
+        }
+
+        // Count every access per address from now on (see bus_profile), or stop counting. Parallel runs aren't
+        // counted. The idle skip is off while the bus counts, the cpu's idle loops are part of the profile.
+        void profile(bool value) { _profile.reset(value ? new bus_profile(_now) : nullptr); }
+        auto profile() const -> const bus_profile* { return _profile.get(); }
 
-        auto attach_cpu(std::unique_ptr<cpu> &&cpu) -> dave::cpu*;
+        // The plain memory backing a page, when a single device decodes the page and backs it with memory. Copying to
+        // and from it bypasses the bus, and the debugger.
+        auto direct(REG8 page) -> REG8* {
+            auto d = _page_device[page];
+            return d == nullptr ? nullptr : d->direct(page);
+        }
+
+        auto attach_cpu(std::unique_ptr<cpu> &&cpu, size_t budget = 1) -> dave::cpu*;
         auto attach_device(std::unique_ptr<device> &&device) -> dave::device*;
 
         void report_cpu_status();
 
+        auto timing() -> device_timing& { return _timing; }
+
         void powerup();
     };
 }
@@ -0,0 +1,29 @@
+#include "timing.h"
+
+namespace dave
+{
+
+device_timing::device_timing()
+: _engine(default_seed), _fixed(0)
+{}
+
+void device_timing::seed(uint32_t value)
+{
+    _engine.seed(value);
+}
+
+void device_timing::fix(size_t ticks)
+{
+    _fixed = ticks;
+}
+
+size_t device_timing::delay(size_t lo, size_t hi)
+{
+    if (_fixed != 0) {
+        return _fixed;
+    }
+    // Not std::uniform_int_distribution - its output differs between standard libraries
+    return lo + (size_t)(_engine() % (hi - lo + 1));
+}
+
+}
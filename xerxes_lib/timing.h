@@ -0,0 +1,35 @@
+#ifndef __TIMINGH
+#define __TIMINGH
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace dave
+{
+    // Source of the randomized delays of devices. Each machine owns one, so the delays only
+    // depend on the seed and two runs with the same seed take exactly the same cycles.
+    class device_timing {
+    private:
+        std::mt19937 _engine;
+        size_t _fixed;
+    public:
+        static const uint32_t default_seed = 5489u;
+
+        device_timing();
+
+        device_timing(const device_timing&) = delete;
+        device_timing(device_timing &&) = delete;
+        auto operator =(const device_timing&)->device_timing& = delete;
+        auto operator =(device_timing &&)->device_timing& = delete;
+
+        void seed(uint32_t value);
+        // Use the same delay for every request, 0 to go back to randomized delays
+        void fix(size_t ticks);
+
+        // A delay in [lo, hi]
+        size_t delay(size_t lo, size_t hi);
+    };
+}
+
+#endif
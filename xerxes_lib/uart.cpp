@@ -0,0 +1,98 @@
+#include "uart.h"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace dave
+{
+
+serial_port::serial_port(int in, int out, bool close)
+: _in(in), _out(out), _close(close)
+{}
+
+serial_port::serial_port(const std::string &path)
+: _in(-1), _out(-1), _close(true)
+{
+    if (path == "-") {
+        _in = 0;
+        _out = 1;
+        _close = false;
+        return;
+    }
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        // A unix socket can't be opened, it is connected to, as a stream
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return;
+        }
+        path.copy(addr.sun_path, path.size());
+        auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd != -1 && connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        _in = _out = fd;
+    }
+    else if (stat(path.c_str(), &st) == 0 && (S_ISFIFO(st.st_mode) || S_ISCHR(st.st_mode))) {
+        _in = _out = open(path.c_str(), O_RDWR);
+    }
+    else {
+        _out = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+}
+
+serial_port::~serial_port()
+{
+    if (_close) {
+        if (_in != -1) {
+            close(_in);
+        }
+        if (_out != -1 && _out != _in) {
+            close(_out);
+        }
+    }
+}
+
+size_t serial_port::receive(REG8 *data, size_t size)
+{
+    if (_in == -1 || size == 0) {
+        return 0;
+    }
+    pollfd p = { _in, POLLIN, 0 };
+    if (poll(&p, 1, 0) <= 0 || (p.revents & POLLIN) == 0) {
+        return 0;
+    }
+    auto n = ::read(_in, data, size);
+    return n > 0 ? (size_t)n : 0;
+}
+
+void serial_port::send(const REG8 *data, size_t size)
+{
+    if (_out == -1) {
+        return;
+    }
+    while(size > 0) {
+        auto n = ::write(_out, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                pollfd p = { _out, POLLOUT, 0 };
+                poll(&p, 1, -1);
+                continue;
+            }
+            return;
+        }
+        data += n;
+        size -= (size_t)n;
+    }
+}
+
+}
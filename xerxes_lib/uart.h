@@ -0,0 +1,155 @@
+#ifndef __UARTH
+#define __UARTH
+
+#include "common.h"
+#include "device.h"
+#include "system_bus.h"
+
+#include <cstring>
+#include <string>
+
+namespace dave
+{
+    // The host side of a serial line: a file descriptor to read from and one to write to (the same one for a
+    // socket or a pipe opened for reading and writing). Either can be -1.
+    class serial_port {
+    private:
+        int _in;
+        int _out;
+        bool _close;
+    public:
+        serial_port(int in, int out, bool close = false);
+        // "-" is stdin/stdout. A fifo or terminal is opened, and a unix socket connected to (as a stream), to read and
+        // write. Any other file is written (created)
+        explicit serial_port(const std::string &path);
+        ~serial_port();
+
+        serial_port(const serial_port&) = delete;
+        serial_port(serial_port &&) = delete;
+        auto operator =(const serial_port&)->serial_port& = delete;
+        auto operator =(serial_port &&)->serial_port& = delete;
+
+        auto is_open() const -> bool { return _in != -1 || _out != -1; }
+
+        // Whatever is waiting, without blocking, up to size bytes
+        auto receive(REG8 *data, size_t size) -> size_t;
+        // All of it
+        void send(const REG8 *data, size_t size);
+    };
+
+    // A UART. Bytes the cpu sends are collected in the transmit FIFO, and written to the host in one go when the
+    // FIFO is full or the line is serviced (every service_cycles bus cycles, on the bus's event schedule). The
+    // service also reads what the host sent into the receive FIFO, in one go.
+    //   _Data   : write to send a byte; read to take the next byte received (0 if none)
+    //   _Status : bit 0 received data waiting, bit 1 transmit FIFO empty, bit 2 receive FIFO overflowed (cleared by reading)
+    //   _Control: bit 0 IRQ while received data waits, bit 1 IRQ when the transmit FIFO was emptied
+    template<REG16 _Data, REG16 _Status, REG16 _Control> class uart : public device {
+    public:
+        static const size_t fifo_size = 256;
+        static const REG8 irq_on_receive = 0x01;
+        static const REG8 irq_on_transmit_empty = 0x02;
+    private:
+        serial_port &_port;
+        size_t _service_cycles;
+        size_t _generation;
+
+        REG8 _tx[fifo_size];
+        size_t _tx_size;
+        REG8 _rx[fifo_size];
+        size_t _rx_head;
+        size_t _rx_size;
+        bool _overflow;
+        REG8 _control;
+        bool _tx_emptied;
+
+        void flush() {
+            if (_tx_size == 0) return;
+            _port.send(_tx, _tx_size);
+            _tx_size = 0;
+            _tx_emptied = true;
+        }
+        void receive() {
+            if (_rx_size == fifo_size) {
+                _overflow = true;
+                return;
+            }
+            // Compact, then read into the free space at the end
+            if (_rx_head != 0) {
+                std::memmove(_rx, _rx + _rx_head, _rx_size);
+                _rx_head = 0;
+            }
+            _rx_size += _port.receive(_rx + _rx_size, fifo_size - _rx_size);
+        }
+    public:
+        uart(system_bus *bus, debugger *debugger, serial_port *port, size_t service_cycles = 1000)
+            : device(bus, debugger), _port(*port), _service_cycles(service_cycles), _generation(0),
+              _tx_size(0), _rx_head(0), _rx_size(0), _overflow(false), _control(0), _tx_emptied(false)
+        {}
+        virtual ~uart() {
+            flush();
+        }
+        uart() = delete;
+        uart(const uart&) = delete;
+        uart(uart &&) = delete;
+        auto operator =(const uart&)->uart& = delete;
+        auto operator =(uart &&)->uart& = delete;
+
+        virtual bool irq() override {
+            return ((_control & irq_on_receive) && _rx_size != 0) || ((_control & irq_on_transmit_empty) && _tx_emptied);
+        }
+        virtual void powerup() override {
+            _bus->schedule(this, _service_cycles, ++_generation);
+        }
+        virtual void event(size_t tag) override {
+            if (tag != _generation) return;
+            flush();
+            receive();
+            _bus->schedule(this, _service_cycles, _generation);
+        }
+        virtual void nop() override { }
+        virtual void write(const REG16 &address, const REG8 *data) override {
+            switch(address) {
+                case _Data:
+                    if (_tx_size == fifo_size) {
+                        flush();
+                    }
+                    _tx[_tx_size++] = *data;
+                    _tx_emptied = false;
+                    break;
+                case _Control:
+                    _control = *data;
+                    break;
+            }
+        }
+        virtual void read(const REG16 &address, REG8 *dest) override {
+            switch(address) {
+                case _Data:
+                    if (_rx_size == 0) {
+                        *dest = 0;
+                    }
+                    else {
+                        _bus->changed();
+                        *dest = _rx[_rx_head++];
+                        _rx_size--;
+                    }
+                    break;
+                case _Status:
+                    if (_overflow || _tx_emptied) {
+                        _bus->changed();
+                    }
+                    *dest = (_rx_size != 0 ? 0x01 : 0x00) | (_tx_size == 0 ? 0x02 : 0x00) | (_overflow ? 0x04 : 0x00);
+                    _overflow = false;
+                    _tx_emptied = false;
+                    break;
+                case _Control:
+                    *dest = _control;
+                    break;
+            }
+        }
+        virtual bool decodes(REG8 page) override {
+            return page == (_Data >> 8) || page == (_Status >> 8) || page == (_Control >> 8);
+        }
+    };
+}
+
+#endif
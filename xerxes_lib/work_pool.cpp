@@ -0,0 +1,70 @@
+#include "work_pool.h"
+
+#include <thread>
+
+namespace dave
+{
+
+work_pool::work_pool(size_t threads)
+{
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    for(size_t i = 0; i < threads; i++) {
+        _queues.push_back(std::make_unique<queue>());
+    }
+}
+
+bool work_pool::try_take(size_t worker, std::function<void()> &task)
+{
+    // Our own queue first, from the front
+    {
+        auto &q = *_queues[worker];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    // Then steal from the back of the others
+    for(size_t i = 1; i < _queues.size(); i++) {
+        auto &q = *_queues[(worker + i) % _queues.size()];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void work_pool::work(size_t worker)
+{
+    // No tasks are added while we run, so once every queue is empty we're done
+    std::function<void()> task;
+    while(try_take(worker, task)) {
+        task();
+    }
+}
+
+void work_pool::run(std::vector<std::function<void()> > &&tasks)
+{
+    for(size_t i = 0; i < tasks.size(); i++) {
+        _queues[i % _queues.size()]->tasks.push_back(std::move(tasks[i]));
+    }
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < _queues.size(); i++) {
+        threads.emplace_back(&work_pool::work, this, i);
+    }
+    work(0);
+    for(auto &t : threads) {
+        t.join();
+    }
+}
+
+}
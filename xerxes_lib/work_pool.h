@@ -0,0 +1,41 @@
+#ifndef __WORK_POOLH
+#define __WORK_POOLH
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dave
+{
+    // Runs a batch of independent tasks on a number of host threads. Every thread has its own queue,
+    // and steals from the back of the other queues when its own runs dry.
+    class work_pool {
+    private:
+        struct queue {
+            std::mutex lock;
+            std::deque<std::function<void()> > tasks;
+        };
+        std::vector<std::unique_ptr<queue> > _queues;
+
+        bool try_take(size_t worker, std::function<void()> &task);
+        void work(size_t worker);
+    public:
+        // 0 threads uses one thread per host core
+        explicit work_pool(size_t threads);
+
+        work_pool(const work_pool&) = delete;
+        work_pool(work_pool &&) = delete;
+        auto operator =(const work_pool&)->work_pool& = delete;
+        auto operator =(work_pool &&)->work_pool& = delete;
+
+        auto threads() const -> size_t { return _queues.size(); }
+
+        // Run all the tasks, and return once they have all completed
+        void run(std::vector<std::function<void()> > &&tasks);
+    };
+}
+
+#endif